@@ -43,3 +43,85 @@ extension NSRect: ObjCNormalizedCoding {
         return decoder.decodeRect(forKey: key)
     }
 }
+
+//MARK: Bulk Coding
+extension NSPoint: ObjCNormalizedBulkCoding {
+    public var littleEndian: NSPoint {
+        return NSPoint(x: x.littleEndian, y: y.littleEndian)
+    }
+    
+    public init(littleEndian value: NSPoint) {
+        self.init(
+            x: CGFloat(littleEndian: value.x),
+            y: CGFloat(littleEndian: value.y)
+        )
+    }
+}
+
+extension NSSize: ObjCNormalizedBulkCoding {
+    public var littleEndian: NSSize {
+        return NSSize(width: width.littleEndian, height: height.littleEndian)
+    }
+    
+    public init(littleEndian value: NSSize) {
+        self.init(
+            width: CGFloat(littleEndian: value.width),
+            height: CGFloat(littleEndian: value.height)
+        )
+    }
+}
+
+extension NSRect: ObjCNormalizedBulkCoding {
+    public var littleEndian: NSRect {
+        return NSRect(origin: origin.littleEndian, size: size.littleEndian)
+    }
+    
+    public init(littleEndian value: NSRect) {
+        self.init(
+            origin: NSPoint(littleEndian: value.origin),
+            size: NSSize(littleEndian: value.size)
+        )
+    }
+}
+
+extension NSPoint: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 2 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
+
+extension NSSize: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 2 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
+
+extension NSRect: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 4 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
@@ -28,3 +28,31 @@ extension CGFloat: ObjCNormalizedCoding {
         #endif
     }
 }
+
+extension CGFloat: ObjCNormalizedBulkCoding {
+    public var littleEndian: CGFloat {
+        return CGFloat(native.littleEndian)
+    }
+    
+    public init(littleEndian value: CGFloat) {
+        self.init(NativeType(littleEndian: value.native))
+    }
+}
+
+extension CGFloat: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 1 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        let value: CGFloat
+        switch size {
+        case 4: value = CGFloat(Float(littleEndian: _loadUnaligned(source)))
+        case 8: value = CGFloat(Double(littleEndian: _loadUnaligned(source)))
+        default: throw _platformWidthScalarSizeError(size, for: key)
+        }
+        destination.storeBytes(of: value, as: CGFloat.self)
+    }
+}
@@ -92,3 +92,112 @@ extension CGAffineTransform: ObjCNormalizedCoding {
         return decoder.decodeCGAffineTransform(forKey: key)
     }
 }
+
+//MARK: CoreGraphics Primitive Bulk Coding
+extension CGVector: ObjCNormalizedBulkCoding {
+    public var littleEndian: CGVector {
+        return CGVector(dx: dx.littleEndian, dy: dy.littleEndian)
+    }
+    
+    public init(littleEndian value: CGVector) {
+        self.init(
+            dx: CGFloat(littleEndian: value.dx),
+            dy: CGFloat(littleEndian: value.dy)
+        )
+    }
+}
+
+extension CGPoint: ObjCNormalizedBulkCoding {
+    public var littleEndian: CGPoint {
+        return CGPoint(x: x.littleEndian, y: y.littleEndian)
+    }
+    
+    public init(littleEndian value: CGPoint) {
+        self.init(
+            x: CGFloat(littleEndian: value.x),
+            y: CGFloat(littleEndian: value.y)
+        )
+    }
+}
+
+extension CGSize: ObjCNormalizedBulkCoding {
+    public var littleEndian: CGSize {
+        return CGSize(width: width.littleEndian, height: height.littleEndian)
+    }
+    
+    public init(littleEndian value: CGSize) {
+        self.init(
+            width: CGFloat(littleEndian: value.width),
+            height: CGFloat(littleEndian: value.height)
+        )
+    }
+}
+
+extension CGRect: ObjCNormalizedBulkCoding {
+    public var littleEndian: CGRect {
+        return CGRect(origin: origin.littleEndian, size: size.littleEndian)
+    }
+    
+    public init(littleEndian value: CGRect) {
+        self.init(
+            origin: CGPoint(littleEndian: value.origin),
+            size: CGSize(littleEndian: value.size)
+        )
+    }
+}
+
+extension CGVector: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 2 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
+
+extension CGPoint: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 2 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
+
+extension CGSize: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 2 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
+
+extension CGRect: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 4 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        try CGFloat._convertPlatformWidthScalar(
+            from: source, size: size, to: destination, for: key
+        )
+    }
+}
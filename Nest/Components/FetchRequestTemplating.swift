@@ -24,6 +24,21 @@ public protocol FetchRequestTemplate {
     var fetchOffset: Int { get }
     
     var fetchBatchSize: Int { get }
+    
+    /// Relationship key paths whose destination objects are fetched with
+    /// the results instead of being faulted in one by one. Ignored with
+    /// dictionary results.
+    var relationshipKeyPathsForPrefetching: [String] { get }
+    
+    /// Names of properties to fetch. All properties are fetched when
+    /// empty.
+    var propertiesToFetch: [String] { get }
+    
+    /// `nil` by default, which keeps the result type of the template in
+    /// the model unless `FetchRequestResult` requires another one.
+    var resultType: NSFetchRequestResultType? { get }
+    
+    var returnsObjectsAsFaults: Bool { get }
 }
 
 extension FetchRequestTemplate {
@@ -42,6 +57,33 @@ extension FetchRequestTemplate {
     public var fetchBatchSize: Int {
         return 0
     }
+    
+    public var relationshipKeyPathsForPrefetching: [String] {
+        return []
+    }
+    
+    public var propertiesToFetch: [String] {
+        return []
+    }
+    
+    public var resultType: NSFetchRequestResultType? {
+        return nil
+    }
+    
+    /// The result type required by `FetchRequestResult`. `nil` for managed
+    /// objects, which leaves the model's choice.
+    internal static var _requiredResultType: NSFetchRequestResultType? {
+        switch FetchRequestResult.self {
+        case is NSManagedObjectID.Type: return .managedObjectIDResultType
+        case is NSDictionary.Type:      return .dictionaryResultType
+        case is NSNumber.Type:          return .countResultType
+        default:                        return nil
+        }
+    }
+    
+    public var returnsObjectsAsFaults: Bool {
+        return true
+    }
 }
 
 extension FetchRequestTemplate where Variable.RawValue == String {
@@ -54,6 +96,12 @@ extension FetchRequestTemplate where Variable.RawValue == String {
 }
 
 extension PersistentController {
+    /// Returns a fetch request made from `template`.
+    ///
+    /// - Notes: The fetch request template and its predicate are prepared
+    /// once per template name and shape of substitution variables, and
+    /// cached. Making a fetch request then only binds the substitution
+    /// variables to the prepared variable slots.
     public func fetchRequest<Template: FetchRequestTemplate>(
         for template: Template
         ) -> NSFetchRequest<Template.FetchRequestResult> where
@@ -64,10 +112,10 @@ extension PersistentController {
             substitutionVariables[name.rawValue] = value
         }
         
-        let fetchRequest = fetchRequestFromTemplate(
+        let fetchRequest = _fetchRequestTemplateCache.fetchRequest(
             named: template.name,
             substitutionVariables: substitutionVariables
-            )! as! NSFetchRequest<Template.FetchRequestResult>
+            ) as! NSFetchRequest<Template.FetchRequestResult>
         
         fetchRequest.sortDescriptors = template.sortDescriptors
         if template.fetchLimit != 0 {
@@ -79,9 +127,471 @@ extension PersistentController {
         if template.fetchBatchSize != 0 {
             fetchRequest.fetchBatchSize = template.fetchBatchSize
         }
+        if !template.relationshipKeyPathsForPrefetching.isEmpty {
+            fetchRequest.relationshipKeyPathsForPrefetching
+                = template.relationshipKeyPathsForPrefetching
+        }
+        if !template.propertiesToFetch.isEmpty {
+            fetchRequest.propertiesToFetch = template.propertiesToFetch
+        }
+        if let resultType
+            = template.resultType ?? Template._requiredResultType
+        {
+            fetchRequest.resultType = resultType
+        }
+        if !template.returnsObjectsAsFaults {
+            fetchRequest.returnsObjectsAsFaults = false
+        }
+        
+        return fetchRequest
+    }
+    
+    /// Fetches object IDs of the objects matched by `template` in
+    /// `context`.
+    ///
+    /// - Notes: Results are cached by the context, the template name and
+    /// the values of substitution variables, and invalidated when objects
+    /// of the fetched entity were changed or saved in the fetching context
+    /// or the saving context. Fetches in a context with unsaved changes
+    /// bypass the cache. At most
+    /// `_FetchRequestTemplateCache.resultCountLimit` results are cached, the
+    /// least recently used ones are evicted first.
+    public func fetchObjectIDs<Template: FetchRequestTemplate>(
+        for template: Template,
+        in context: NSManagedObjectContext
+        ) throws -> [NSManagedObjectID] where
+        Template.Variable.RawValue == String
+    {
+        let fetchRequest = self.fetchRequest(for: template)
+        
+        // Results including pending changes are neither cached nor served
+        // from the cache.
+        if context.hasChanges {
+            let objectIDRequest = fetchRequest.copy()
+                as! NSFetchRequest<NSManagedObjectID>
+            objectIDRequest.resultType = .managedObjectIDResultType
+            return try context.fetch(objectIDRequest)
+        }
+        
+        var substitutionVariables = [String : Any]()
+        for (name, value) in template.primitiveSubstitutionVariables {
+            substitutionVariables[name.rawValue] = value
+        }
+        
+        let key = _FetchRequestTemplateCache.ResultKey(
+            context: _FetchRequestTemplateCache.token(for: context),
+            name: template.name,
+            substitutionVariables: substitutionVariables as NSDictionary,
+            sortDescriptors: fetchRequest.sortDescriptors ?? [],
+            fetchLimit: fetchRequest.fetchLimit,
+            fetchOffset: fetchRequest.fetchOffset
+        )
+        
+        let (cachedObjectIDs, generation) = _fetchRequestTemplateCache
+            .objectIDs(for: key)
+        
+        if let objectIDs = cachedObjectIDs {
+            return objectIDs
+        }
+        
+        let objectIDRequest = fetchRequest.copy()
+            as! NSFetchRequest<NSManagedObjectID>
+        objectIDRequest.resultType = .managedObjectIDResultType
+        
+        let objectIDs = try context.fetch(objectIDRequest)
+        
+        _fetchRequestTemplateCache.setObjectIDs(
+            objectIDs,
+            for: key,
+            entityName: fetchRequest.entityName ?? "",
+            generation: generation
+        )
+        
+        return objectIDs
+    }
+}
+
+/// Caches prepared fetch request templates and object IDs fetched with
+/// them for a `PersistentController`.
+internal final class _FetchRequestTemplateCache {
+    internal unowned let managedObjectModel: NSManagedObjectModel
+    
+    internal init(managedObjectModel: NSManagedObjectModel) {
+        self.managedObjectModel = managedObjectModel
+    }
+    
+    /// The maximum count of cached results.
+    internal static let resultCountLimit = 256
+    
+    /// Returns a token identifying `context`, which unlike its
+    /// `ObjectIdentifier` is never reused by another context.
+    internal static func token(for context: NSManagedObjectContext) -> UInt64 {
+        if let token = objc_getAssociatedObject(context, &_contextTokenKey)
+            as? NSNumber
+        {
+            return token.uint64Value
+        }
+        
+        let token = _contextTokenQueue.sync { () -> UInt64 in
+            _nextContextToken += 1
+            return _nextContextToken
+        }
+        
+        objc_setAssociatedObject(
+            context,
+            &_contextTokenKey,
+            NSNumber(value: token),
+            .OBJC_ASSOCIATION_RETAIN
+        )
+        
+        return token
+    }
+    
+    internal struct ResultKey: Hashable {
+        let context: UInt64
+        let name: String
+        let substitutionVariables: NSDictionary
+        let sortDescriptors: [NSSortDescriptor]
+        let fetchLimit: Int
+        let fetchOffset: Int
+        
+        var hashValue: Int {
+            return name.hashValue ^ substitutionVariables.hash
+        }
+        
+        static func == (lhs: ResultKey, rhs: ResultKey) -> Bool {
+            return lhs.context == rhs.context
+                && lhs.name == rhs.name
+                && lhs.substitutionVariables == rhs.substitutionVariables
+                && lhs.sortDescriptors == rhs.sortDescriptors
+                && lhs.fetchLimit == rhs.fetchLimit
+                && lhs.fetchOffset == rhs.fetchOffset
+        }
+    }
+    
+    internal func fetchRequest(
+        named name: String,
+        substitutionVariables: [String : Any]
+        ) -> NSFetchRequest<NSFetchRequestResult>
+    {
+        // The shape is the sorted names of substitution variables.
+        let shape = name + "\u{0}" + substitutionVariables.keys.sorted()
+            .joined(separator: "\u{0}")
+        
+        let preparedRequest = _queue.sync { _preparedRequests[shape] }
+            ?? _prepareRequest(named: name, shape: shape)
+        
+        let fetchRequest = preparedRequest.template.copy()
+            as! NSFetchRequest<NSFetchRequestResult>
+        
+        fetchRequest.predicate = preparedRequest.predicate?.bind(
+            substitutionVariables
+        )
         
         return fetchRequest
     }
+    
+    /// Returns cached object IDs for `key` and the generation of results,
+    /// which shall be passed to `setObjectIDs(_:for:entityName:generation:)`
+    /// when nothing was cached.
+    internal func objectIDs(for key: ResultKey)
+        -> (objectIDs: [NSManagedObjectID]?, generation: Int)
+    {
+        return _queue.sync {
+            guard var result = _results[key] else {
+                return (nil, _resultGeneration)
+            }
+            _resultAccessCount += 1
+            result.lastAccess = _resultAccessCount
+            _results[key] = result
+            return (result.objectIDs, _resultGeneration)
+        }
+    }
+    
+    /// Caches `objectIDs` unless results were invalidated since
+    /// `generation`, in which case `objectIDs` might be stale.
+    internal func setObjectIDs(
+        _ objectIDs: [NSManagedObjectID],
+        for key: ResultKey,
+        entityName: String,
+        generation: Int
+        )
+    {
+        _queue.sync {
+            guard generation == _resultGeneration else { return }
+            
+            if _results[key] == nil
+                && _results.count >= _FetchRequestTemplateCache.resultCountLimit,
+                let leastRecentlyUsed = _results.min(by: {
+                    $0.value.lastAccess < $1.value.lastAccess
+                })
+            {
+                _results.removeValue(forKey: leastRecentlyUsed.key)
+            }
+            
+            _resultAccessCount += 1
+            _results[key] = (entityName, objectIDs, _resultAccessCount)
+        }
+    }
+    
+    /// Invalidates cached object IDs of `entities` and their super
+    /// entities. `entities` is not evaluated when nothing was cached.
+    internal func invalidateObjectIDs(
+        for entities: @autoclosure () -> [NSEntityDescription]
+        )
+    {
+        let hasResults: Bool = _queue.sync {
+            _resultGeneration += 1
+            return !_results.isEmpty
+        }
+        
+        guard hasResults else { return }
+        
+        var entityNames = Set<String>()
+        
+        for eachEntity in entities() {
+            var entity: NSEntityDescription? = eachEntity
+            while let eachEntity = entity {
+                if let name = eachEntity.name {
+                    entityNames.insert(name)
+                }
+                entity = eachEntity.superentity
+            }
+        }
+        
+        guard !entityNames.isEmpty else { return }
+        
+        _queue.sync {
+            for (key, value) in _results
+                where entityNames.contains(value.entityName)
+            {
+                _results.removeValue(forKey: key)
+            }
+        }
+    }
+    
+    private func _prepareRequest(
+        named name: String,
+        shape: String
+        ) -> _PreparedRequest
+    {
+        guard let template = managedObjectModel.fetchRequestTemplate(
+            forName: name
+            ) else
+        {
+            fatalError("No fetch request template named \(name) in managed object model: \(managedObjectModel)")
+        }
+        
+        let preparedRequest = _PreparedRequest(
+            template: template,
+            predicate: template.predicate.map(_PreparedPredicate.init)
+        )
+        
+        _queue.sync { _preparedRequests[shape] = preparedRequest }
+        
+        return preparedRequest
+    }
+    
+    private struct _PreparedRequest {
+        let template: NSFetchRequest<NSFetchRequestResult>
+        let predicate: _PreparedPredicate?
+    }
+    
+    private let _queue = DispatchQueue(
+        label: "com.WeZZard.Nest.PersistentController.FetchRequestTemplateCache"
+    )
+    
+    private var _preparedRequests = [String : _PreparedRequest]()
+    
+    private var _results = [
+        ResultKey : (
+            entityName: String,
+            objectIDs: [NSManagedObjectID],
+            lastAccess: UInt64
+        )
+    ]()
+    
+    /// Increased on each access to `_results`, which orders the results by
+    /// recency.
+    private var _resultAccessCount: UInt64 = 0
+    
+    /// Increased on each invalidation.
+    private var _resultGeneration: Int = 0
+}
+
+private var _contextTokenKey =
+"com.WeZZard.Nest.PersistentController.FetchRequestTemplateCache.contextToken"
+
+private let _contextTokenQueue = DispatchQueue(
+    label: "com.WeZZard.Nest.PersistentController.FetchRequestTemplateCache.ContextToken"
+)
+
+private var _nextContextToken: UInt64 = 0
+
+/// A predicate whose sub-predicates without substitution variables are
+/// kept as is, and whose variable slots are located once, thus binding
+/// substitution variables only rebuilds the predicates along the paths to
+/// the slots.
+private indirect enum _PreparedPredicate {
+    case constant(NSPredicate)
+    case compound(NSCompoundPredicate.LogicalType, [_PreparedPredicate])
+    case comparison(
+        NSComparisonPredicate,
+        left: _PreparedExpression,
+        right: _PreparedExpression
+    )
+    /// Variables nested in other expressions are substituted by the
+    /// predicate itself.
+    case substituting(NSPredicate)
+    
+    init(_ predicate: NSPredicate) {
+        switch predicate {
+        case let compound as NSCompoundPredicate:
+            let subpredicates = (compound.subpredicates as! [NSPredicate])
+                .map(_PreparedPredicate.init)
+            
+            if subpredicates.contains(where: { !$0.isConstant }) {
+                self = .compound(compound.compoundPredicateType, subpredicates)
+            } else {
+                self = .constant(predicate)
+            }
+        case let comparison as NSComparisonPredicate:
+            let left = _PreparedExpression(comparison.leftExpression)
+            let right = _PreparedExpression(comparison.rightExpression)
+            
+            switch (left, right) {
+            case (.constant, .constant):
+                self = .constant(predicate)
+            case (.nested, _), (_, .nested):
+                self = .substituting(predicate)
+            default:
+                self = .comparison(comparison, left: left, right: right)
+            }
+        default:
+            self = .constant(predicate)
+        }
+    }
+    
+    var isConstant: Bool {
+        if case .constant = self { return true }
+        return false
+    }
+    
+    func bind(_ variables: [String : Any]) -> NSPredicate {
+        switch self {
+        case let .constant(predicate):
+            return predicate
+        case let .compound(type, subpredicates):
+            return NSCompoundPredicate(
+                type: type,
+                subpredicates: subpredicates.map { $0.bind(variables) }
+            )
+        case let .comparison(comparison, left, right):
+            let leftExpression = left.bind(variables)
+            let rightExpression = right.bind(variables)
+            
+            if comparison.predicateOperatorType == .customSelector,
+                let selector = comparison.customSelector
+            {
+                return NSComparisonPredicate(
+                    leftExpression: leftExpression,
+                    rightExpression: rightExpression,
+                    customSelector: selector
+                )
+            }
+            
+            return NSComparisonPredicate(
+                leftExpression: leftExpression,
+                rightExpression: rightExpression,
+                modifier: comparison.comparisonPredicateModifier,
+                type: comparison.predicateOperatorType,
+                options: comparison.options
+            )
+        case let .substituting(predicate):
+            return predicate.withSubstitutionVariables(variables)
+        }
+    }
+}
+
+private enum _PreparedExpression {
+    case constant(NSExpression)
+    case variable(NSExpression)
+    case nested
+    
+    init(_ expression: NSExpression) {
+        switch expression.expressionType {
+        case .variable:
+            self = .variable(expression)
+        default:
+            self = expression._containsVariable
+                ? .nested : .constant(expression)
+        }
+    }
+    
+    func bind(_ variables: [String : Any]) -> NSExpression {
+        switch self {
+        case let .constant(expression):
+            return expression
+        case let .variable(expression):
+            guard let value = variables[expression.variable] else {
+                return expression
+            }
+            return NSExpression(forConstantValue: value)
+        case .nested:
+            fatalError("Nested variables are substituted by the predicate.")
+        }
+    }
+}
+
+extension NSExpression {
+    /// Whether the expression tree contains a variable expression. Unknown
+    /// expression types are assumed to contain one.
+    fileprivate var _containsVariable: Bool {
+        switch expressionType {
+        case .variable:
+            return true
+        case .constantValue, .evaluatedObject, .keyPath, .anyKey:
+            return false
+        case .function:
+            return operand._containsVariable
+                || (arguments ?? []).contains { $0._containsVariable }
+        case .block:
+            return (arguments ?? []).contains { $0._containsVariable }
+        case .unionSet, .intersectSet, .minusSet:
+            return left._containsVariable || right._containsVariable
+        case .aggregate:
+            if let expressions = collection as? [NSExpression] {
+                return expressions.contains { $0._containsVariable }
+            }
+            return false
+        case .subquery:
+            let collectionContainsVariable
+                = (collection as? NSExpression)?._containsVariable ?? true
+            return collectionContainsVariable || predicate._containsVariable
+        case .conditional:
+            return predicate._containsVariable
+                || trueExpression._containsVariable
+                || falseExpression._containsVariable
+        default:
+            return true
+        }
+    }
+}
+
+extension NSPredicate {
+    /// Whether the predicate tree contains a variable expression.
+    fileprivate var _containsVariable: Bool {
+        switch self {
+        case let compound as NSCompoundPredicate:
+            return (compound.subpredicates as! [NSPredicate])
+                .contains { $0._containsVariable }
+        case let comparison as NSComparisonPredicate:
+            return comparison.leftExpression._containsVariable
+                || comparison.rightExpression._containsVariable
+        default:
+            return false
+        }
+    }
 }
 
 extension SingletonPersistentController where Self: PersistentController {
@@ -174,6 +174,12 @@ typedef void (* LTLaunchTaskHandler)(
 typedef void (* LTLaunchTaskContextCleanupHandler)(void * context)
 NS_SWIFT_UNAVAILABLE("Define launch task context cleanup handler in Objective-C.");
 
+/// Represents a completion handler of a launch task. The framework calls
+/// the handler once all recognized launch tasks for the specified selector
+/// prefix were handled, and before launch tasks of lower priorities begin.
+typedef void (* LTLaunchTaskCompletionHandler)(void * context)
+NS_SWIFT_UNAVAILABLE("Define launch task completion handler in Objective-C.");
+
 /// Registers a launch task.
 ///
 /// - Parameter selectorPrefix: The prefix of the launch task. Begining
@@ -209,6 +215,23 @@ FOUNDATION_EXPORT BOOL LTRegisterLaunchTask(
     int priority
 ) NS_SWIFT_UNAVAILABLE("You shall call this function in +load method with Objective-C code.");
 
+/// Registers a launch task with a completion handler.
+///
+/// - Parameter completionHandler: The handler called after all recognized
+/// launch tasks for the specified selector prefix were handled. Use it to
+/// finish the work collected by `taskHandler` before launch tasks of lower
+/// priorities are performed.
+///
+/// - Notes: Other parameters are same to `LTRegisterLaunchTask`.
+FOUNDATION_EXPORT BOOL LTRegisterLaunchTaskWithCompletionHandler(
+    const char * selectorPrefix,
+    const LTLaunchTaskHandler taskHandler,
+    const void * __nullable context,
+    const LTLaunchTaskCompletionHandler __nullable completionHandler,
+    const LTLaunchTaskContextCleanupHandler __nullable contextCleanupHandler,
+    int priority
+) NS_SWIFT_UNAVAILABLE("You shall call this function in +load method with Objective-C code.");
+
 typedef NS_ENUM(NSInteger, NSMainBundleCategory) {
     NSMainBundleCategoryNotMainBundle,
     NSMainBundleCategoryApplication,
@@ -17,6 +17,7 @@ typedef struct _LTLaunchTaskInfo {
     size_t selectorPrefixLength;
     LTLaunchTaskHandler selectorHandler;
     const void * context;
+    LTLaunchTaskCompletionHandler completionHandler;
     LTLaunchTaskContextCleanupHandler contextCleanupHandler;
     int priority; // 0 by default
 } LTLaunchTaskInfo;
@@ -82,6 +83,7 @@ static LTLaunchTaskInfo * LTLaunchTaskInfoCreate(
     const char *,
     const LTLaunchTaskHandler,
     const void *,
+    const LTLaunchTaskCompletionHandler,
     const LTLaunchTaskContextCleanupHandler,
     int
 );
@@ -183,6 +185,25 @@ BOOL LTRegisterLaunchTask(
     const LTLaunchTaskContextCleanupHandler contextCleanupHandler,
     int priority
     )
+{
+    return LTRegisterLaunchTaskWithCompletionHandler(
+        selectorPrefix,
+        selectorHandler,
+        context,
+        NULL,
+        contextCleanupHandler,
+        priority
+    );
+}
+
+BOOL LTRegisterLaunchTaskWithCompletionHandler(
+    const char * selectorPrefix,
+    const LTLaunchTaskHandler selectorHandler,
+    const void * context,
+    const LTLaunchTaskCompletionHandler completionHandler,
+    const LTLaunchTaskContextCleanupHandler contextCleanupHandler,
+    int priority
+    )
 {
     if (!kHasLaunchTasksPerformerInjected) {
         kIsLaunchTasksPerformerInjectionSucceeded
@@ -200,6 +221,7 @@ BOOL LTRegisterLaunchTask(
         selectorPrefix,
         selectorHandler,
         context,
+        completionHandler,
         contextCleanupHandler,
         priority
     );
@@ -303,6 +325,7 @@ LTLaunchTaskInfo * LTLaunchTaskInfoCreate(
     const char * selectorPrefix,
     const LTLaunchTaskHandler launchTaskSelectorHandler,
     const void * context,
+    const LTLaunchTaskCompletionHandler completionHandler,
     const LTLaunchTaskContextCleanupHandler contextCleanupHandler,
     int priotity
     )
@@ -319,6 +342,7 @@ LTLaunchTaskInfo * LTLaunchTaskInfoCreate(
         prefixLength,
         launchTaskSelectorHandler,
         context, 
+        completionHandler,
         contextCleanupHandler,
         0
     };
@@ -477,6 +501,10 @@ void LTPerformLaunchTasksOnLoadedClasses(const id firstArg, ...) {
                     };
                     CFArrayApplyFunction(classBuffer, totalRange, &LTBufferedClassScanAndPerformLaunchTask, &context);
                 }
+                
+                if (info -> completionHandler != NULL) {
+                    (* info -> completionHandler)((void *)info -> context);
+                }
             }
             
             CFRelease(classBuffer);
@@ -644,6 +672,7 @@ BOOL LTLaunchTaskInfoEqualToInfo(
     return (strcmp(info1 -> selectorPrefix, info2 -> selectorPrefix) == 0)
         && info1 -> selectorPrefixLength    == info2 -> selectorPrefixLength
         && info1 -> selectorHandler         == info2 -> selectorHandler
+        && info1 -> completionHandler       == info2 -> completionHandler
         && info1 -> contextCleanupHandler   == info2 -> contextCleanupHandler;
 }
 
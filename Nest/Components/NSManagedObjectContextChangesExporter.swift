@@ -33,11 +33,17 @@ tvOS 9.0,
 watchOS 2.0,
 *)
 public class NSManagedObjectContextChangesExporter: NSObject {
+    /// Creates an exporter exports changes saved by `context`.
+    ///
+    /// - Parameter journal: The journal to append changes to. When `nil`,
+    /// changes are archived into the user defaults offered by the delegate.
     public init(
-        context: NSManagedObjectContext
+        context: NSManagedObjectContext,
+        journal: NSManagedObjectContextChangesJournal? = nil
         )
     {
         _context = context
+        self.journal = journal
         super.init()
         NotificationCenter.default.addObserver(
             self,
@@ -57,6 +63,28 @@ public class NSManagedObjectContextChangesExporter: NSObject {
     
     @objc(_handleManagedObjectContextDidSave:)
     private func _handle(managedObjectContextDidSave: Notification) {
+        if let journal = journal {
+            var newChanges = NSManagedObjectContextChangesJournal.Changes()
+            
+            let changes = managedObjectContextDidSave
+                ._extractManagedObjectChanges()
+            
+            for (k, v) in changes {
+                newChanges[k.rawValue] = v.map {
+                    $0.objectID.uriRepresentation()
+                }
+            }
+            
+            do {
+                try journal.append(newChanges)
+            } catch let error {
+                #if DEBUG
+                    NSLog("\(self): Cannot append changes to journal: \(error)")
+                #endif
+            }
+            
+            return
+        }
         
         guard let userDefaults = delegate?.persistentUserDefault(for: self)
             else
@@ -106,6 +134,8 @@ public class NSManagedObjectContextChangesExporter: NSObject {
     
     public weak var delegate: NSManagedObjectContextChangesExporterDelegate?
     
+    public let journal: NSManagedObjectContextChangesJournal?
+    
     private let _context: NSManagedObjectContext
 }
 
@@ -29,6 +29,28 @@ public protocol NSManagedObjectContextChangesImporterDelegate: class {
         _ sender: NSManagedObjectContextChangesImporter
     )
     
+    func managedObjectContextChangesImporter(
+        _ sender: NSManagedObjectContextChangesImporter,
+        didFailToImportWith error: Error
+    )
+}
+
+@available(
+iOSApplicationExtension 9.0,
+OSXApplicationExtension 10.11,
+tvOS 9.0,
+watchOS 2.0,
+*)
+extension NSManagedObjectContextChangesImporterDelegate {
+    public func managedObjectContextChangesImporter(
+        _ sender: NSManagedObjectContextChangesImporter,
+        didFailToImportWith error: Error
+        )
+    {
+        #if DEBUG
+            NSLog("\(sender): Cannot import changes: \(error)")
+        #endif
+    }
 }
 
 @available(
@@ -38,19 +60,45 @@ tvOS 9.0,
 watchOS 2.0,
 *)
 public class NSManagedObjectContextChangesImporter: NSObject {
-    public init(context: NSManagedObjectContext) {
+    /// Creates an importer imports changes into `context`.
+    ///
+    /// - Parameter journal: The journal to import changes from. When `nil`,
+    /// changes are unarchived from the user defaults offered by the
+    /// delegate.
+    public init(
+        context: NSManagedObjectContext,
+        journal: NSManagedObjectContextChangesJournal? = nil
+        )
+    {
         _context = context
+        self.journal = journal
         super.init()
     }
     
-    public func `import`() {
+    /// Imports the exported changes in the background.
+    ///
+    /// Changes are streamed from the exported store and merged in chunks
+    /// of at most `chunkSize` unique object IDs, where duplicate object IDs
+    /// across exported saves are merged once. Each chunk is merged with one
+    /// call and saved into the importer's context.
+    ///
+    /// - Returns: A progress reports the import, which could be cancelled.
+    /// A cancelled import stops after the chunk being merged, and the
+    /// unmerged changes are left for the next import. Returns `nil` when
+    /// there is nothing to import.
+    @discardableResult
+    public func `import`() -> Progress? {
+        if let journal = journal {
+            return _importChanges(from: journal)
+        }
+        
         guard let userDefaults = delegate?.persistentUserDefault(for: self)
             else
         {
             #if DEBUG
                 NSLog("\(self): No delegate set.")
             #endif
-            return
+            return nil
         }
         
         guard let key = delegate?.managedObjectContextChangesImporter(
@@ -62,7 +110,7 @@ public class NSManagedObjectContextChangesImporter: NSObject {
             #if DEBUG
                 NSLog("\(self): No delegate set.")
             #endif
-            return
+            return nil
         }
         
         let extensionObjectChagnes = userDefaults.object(forKey: key)
@@ -73,54 +121,264 @@ public class NSManagedObjectContextChangesImporter: NSObject {
         userDefaults.removeObject(forKey: key)
         userDefaults.synchronize()
         
-        if let extensionObjectChagnes = extensionObjectChagnes {
-            _retainedSelf = self
-            
-            let importContext = NSManagedObjectContext(
-                concurrencyType: .privateQueueConcurrencyType
-            )
+        guard let entries = extensionObjectChagnes, !entries.isEmpty else {
+            return nil
+        }
+        
+        let progress = Progress(totalUnitCount: Int64(entries.count))
+        
+        _merge(
+            from: { (body) in
+                for (index, eachEntry) in entries.enumerated() {
+                    var changes = _Changes()
+                    for (k, v) in eachEntry {
+                        if let key = k.base as? String {
+                            changes[key] = v
+                        }
+                    }
+                    if try !body(changes, Int64(index + 1)) {
+                        return
+                    }
+                }
+            },
+            progress: progress
+        ) { (mergedUnitCount) in
+            // Puts the unmerged entries back, before the ones exported
+            // during the import, for the next import.
+            let unmergedEntries = Array(entries.dropFirst(Int(mergedUnitCount)))
             
-            NotificationCenter.default.addObserver(
-                self,
-                selector:
-                #selector(_handle(managedObjectContextDidSave:)),
-                name: .NSManagedObjectContextDidSave,
-                object: importContext
-            )
+            guard !unmergedEntries.isEmpty else { return }
             
-            importContext.parent = _context
+            let newEntries = userDefaults.object(forKey: key)
+                .flatMap {$0 as? Data}
+                .map {NSKeyedUnarchiver.unarchiveObject(with: $0)}
+                .flatMap {$0 as? [[AnyHashable : [URL]]]}
             
-            importContext.perform {
-                for eachChange in extensionObjectChagnes {
-                    NSManagedObjectContext.mergeChanges(
-                        fromRemoteContextSave: eachChange,
-                        into: [importContext]
-                    )
+            userDefaults.set(
+                NSKeyedArchiver.archivedData(
+                    withRootObject: unmergedEntries + (newEntries ?? [])
+                ),
+                forKey: key
+            )
+            userDefaults.synchronize()
+        }
+        
+        return progress
+    }
+    
+    private func _importChanges(
+        from journal: NSManagedObjectContextChangesJournal
+        ) -> Progress?
+    {
+        let rotatedJournalURLs: [URL]
+        
+        do {
+            rotatedJournalURLs = try journal.rotate()
+        } catch let error {
+            delegate?.managedObjectContextChangesImporter(
+                self, didFailToImportWith: error
+            )
+            return nil
+        }
+        
+        // Units are bytes of journals.
+        let journalLengths = rotatedJournalURLs.map {
+            (try? FileManager.default.attributesOfItem(atPath: $0.path))
+                .flatMap { $0[.size] as? NSNumber }
+                .map { $0.int64Value } ?? 0
+        }
+        
+        let totalLength = journalLengths.reduce(0, +)
+        
+        guard totalLength > 0 else {
+            rotatedJournalURLs.forEach {
+                try? journal.removeRotatedJournal(at: $0)
+            }
+            return nil
+        }
+        
+        let progress = Progress(totalUnitCount: totalLength)
+        
+        _merge(
+            from: { (body) in
+                var journalStart: Int64 = 0
+                for (index, eachURL) in rotatedJournalURLs.enumerated() {
+                    var shouldContinue = true
+                    try NSManagedObjectContextChangesJournal._forEachRecord(
+                        inJournalAt: eachURL
+                    ) { (changes, endOffset) in
+                        shouldContinue = try body(
+                            changes, journalStart + Int64(endOffset)
+                        )
+                        return shouldContinue
+                    }
+                    guard shouldContinue else { return }
+                    journalStart += journalLengths[index]
                 }
-                do {
-                    try importContext.save()
-                } catch let error {
-                    fatalError(error.localizedDescription)
+            },
+            progress: progress
+        ) { (mergedUnitCount) in
+            // Rotated journals are removed only after their changes were
+            // saved, and a partially merged one is compacted, thus an
+            // interrupted import resumes from the unmerged changes.
+            var journalStart: Int64 = 0
+            for (index, eachURL) in rotatedJournalURLs.enumerated() {
+                let journalEnd = journalStart + journalLengths[index]
+                
+                if mergedUnitCount >= journalEnd {
+                    try? journal.removeRotatedJournal(at: eachURL)
+                } else if mergedUnitCount > journalStart {
+                    try? journal._removeRecords(
+                        before: Int(mergedUnitCount - journalStart),
+                        inRotatedJournalAt: eachURL
+                    )
                 }
+                
+                journalStart = journalEnd
             }
         }
+        
+        return progress
     }
     
-    @objc(_handleManagedObjectContextDidSave:)
-    private func _handle(managedObjectContextDidSave: Notification) {
-        NotificationCenter.default.removeObserver(
-            self,
-            name: .NSManagedObjectContextDidSave,
-            object: managedObjectContextDidSave.object
+    /// Merges changes emitted by `source` in chunks on a private queue
+    /// context, then calls `completion` with the unit count of changes
+    /// which were merged and saved.
+    ///
+    /// - Parameter source: Emits changes with the unit count completed
+    /// after them, until the passed closure returns `false`.
+    private func _merge(
+        from source: @escaping _ChangesSource,
+        progress: Progress,
+        completion: @escaping (_ mergedUnitCount: Int64) -> Void
         )
-        _retainedSelf = nil
-        delegate?.managedObjectContextChangesImporterDidImport(self)
+    {
+        _retainedSelf = self
+        
+        let importContext = NSManagedObjectContext(
+            concurrencyType: .privateQueueConcurrencyType
+        )
+        
+        importContext.parent = _context
+        
+        let chunkSize = max(self.chunkSize, 1)
+        
+        importContext.perform {
+            var chunk = _ChangesChunk()
+            var chunkUnitCount: Int64 = 0
+            var mergedUnitCount: Int64 = 0
+            var errorOrNil: Error?
+            
+            func mergeChunk() throws {
+                guard !chunk.isEmpty else { return }
+                
+                NSManagedObjectContext.mergeChanges(
+                    fromRemoteContextSave: chunk.changes,
+                    into: [importContext]
+                )
+                
+                try importContext.save()
+                
+                // Keeps the memory usage bounded by the chunk size.
+                importContext.reset()
+                
+                chunk = _ChangesChunk()
+                mergedUnitCount = chunkUnitCount
+                progress.completedUnitCount = mergedUnitCount
+            }
+            
+            do {
+                try source { (changes, unitCount) in
+                    if progress.isCancelled {
+                        return false
+                    }
+                    
+                    chunk.add(changes)
+                    chunkUnitCount = unitCount
+                    
+                    if chunk.count >= chunkSize {
+                        try mergeChunk()
+                    }
+                    
+                    return true
+                }
+                
+                if !progress.isCancelled {
+                    try mergeChunk()
+                }
+            } catch let error {
+                errorOrNil = error
+                importContext.rollback()
+            }
+            
+            completion(mergedUnitCount)
+            
+            self._retainedSelf = nil
+            
+            if let error = errorOrNil {
+                self.delegate?.managedObjectContextChangesImporter(
+                    self, didFailToImportWith: error
+                )
+            } else if !progress.isCancelled {
+                progress.completedUnitCount = progress.totalUnitCount
+                self.delegate?.managedObjectContextChangesImporterDidImport(
+                    self
+                )
+            }
+        }
     }
     
     public weak var delegate: NSManagedObjectContextChangesImporterDelegate?
     
+    public let journal: NSManagedObjectContextChangesJournal?
+    
+    /// The maximum count of unique object IDs merged at once.
+    public var chunkSize: Int = 1024
+    
     private let _context: NSManagedObjectContext
     
     private var _retainedSelf: NSManagedObjectContextChangesImporter?
 }
 
+private typealias _Changes = [String: [URL]]
+
+private typealias _ChangesSource
+    = (_ body: (_Changes, Int64) throws -> Bool) throws -> Void
+
+/// Changes of several exported saves, where each object ID appears once.
+private struct _ChangesChunk {
+    private var _objectIDs = [String: Set<URL>]()
+    
+    private(set) var count = 0
+    
+    var isEmpty: Bool { return count == 0 }
+    
+    mutating func add(_ changes: _Changes) {
+        for (key, uris) in changes {
+            // Removes the set from the dictionary to mutate it in place.
+            var objectIDs = _objectIDs.removeValue(forKey: key) ?? []
+            for eachURI in uris where objectIDs.insert(eachURI).inserted {
+                count += 1
+            }
+            _objectIDs[key] = objectIDs
+        }
+    }
+    
+    /// Changes to merge with one call. Deleted objects are not merged as
+    /// inserted or updated ones.
+    var changes: [AnyHashable : [URL]] {
+        let deleted = _objectIDs[NSDeletedObjectsKey] ?? []
+        
+        var changes = [AnyHashable : [URL]]()
+        
+        for (key, objectIDs) in _objectIDs {
+            if key == NSDeletedObjectsKey || deleted.isEmpty {
+                changes[key] = Array(objectIDs)
+            } else {
+                changes[key] = Array(objectIDs.subtracting(deleted))
+            }
+        }
+        
+        return changes
+    }
+}
@@ -0,0 +1,435 @@
+//
+//  NSManagedObjectContextChangesJournal.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import Foundation
+
+public enum NSManagedObjectContextChangesJournalError: Error {
+    case posixError(function: String, code: Int32)
+    
+    case partialWrite(expectedLength: Int, writtenLength: Int)
+}
+
+/// An append-only file of managed object context changes, which is shared
+/// between processes (typically an app and its extensions) by placing it in
+/// a shared container.
+///
+/// Each save is appended as one length-prefixed binary record with a single
+/// `write`, thus exporting is O(1) per save. An import rotates the journal
+/// aside, reads the rotated records and then removes them, which leaves the
+/// journal compacted to the records appended since.
+///
+/// Record layout, all integers are little-endian:
+///
+/// | Magic (UInt32) | Payload Length (UInt32) | Checksum (UInt32) | Payload |
+///
+/// The payload contains the object IDs of each change kind, grouped by the
+/// URI prefix shared by the object IDs of the same entity.
+@available(
+iOSApplicationExtension 9.0,
+OSXApplicationExtension 10.11,
+tvOS 9.0,
+watchOS 2.0,
+*)
+public final class NSManagedObjectContextChangesJournal {
+    public enum SynchronizationPolicy {
+        /// Leaves flushing to the file system.
+        case none
+        /// Flushes each record to the storage device before returning.
+        case always
+    }
+    
+    public typealias Changes = [String: [URL]]
+    
+    public let url: URL
+    
+    public let synchronizationPolicy: SynchronizationPolicy
+    
+    public init(url: URL, synchronizationPolicy: SynchronizationPolicy = .none)
+    {
+        self.url = url
+        self.synchronizationPolicy = synchronizationPolicy
+    }
+    
+    // MARK: Appending
+    /// Appends `changes`, whose keys are change keys like
+    /// `NSInsertedObjectsKey` and values are object ID URIs, as one record.
+    public func append(_ changes: Changes) throws {
+        let record = NSManagedObjectContextChangesJournal._makeRecord(
+            with: changes
+        )
+        
+        while true {
+            let descriptor = open(url.path, O_WRONLY | O_APPEND | O_CREAT, 0o644)
+            
+            guard descriptor >= 0 else {
+                throw NSManagedObjectContextChangesJournalError.posixError(
+                    function: "open", code: errno
+                )
+            }
+            
+            defer { close(descriptor) }
+            
+            guard flock(descriptor, LOCK_EX) == 0 else {
+                throw NSManagedObjectContextChangesJournalError.posixError(
+                    function: "flock", code: errno
+                )
+            }
+            
+            // The journal may have been rotated between opening and locking,
+            // in which case the record goes to the new journal.
+            if !_isDescriptor(descriptor, referringTo: url) {
+                continue
+            }
+            
+            let writtenLength = record.withUnsafeBytes {
+                (bytes: UnsafePointer<UInt8>) -> Int in
+                write(descriptor, bytes, record.count)
+            }
+            
+            guard writtenLength == record.count else {
+                if writtenLength < 0 {
+                    throw NSManagedObjectContextChangesJournalError.posixError(
+                        function: "write", code: errno
+                    )
+                }
+                throw NSManagedObjectContextChangesJournalError.partialWrite(
+                    expectedLength: record.count,
+                    writtenLength: writtenLength
+                )
+            }
+            
+            if case .always = synchronizationPolicy {
+                if fcntl(descriptor, F_FULLFSYNC) == -1 {
+                    fsync(descriptor)
+                }
+            }
+            
+            return
+        }
+    }
+    
+    // MARK: Rotating
+    /// Moves the journal aside and returns all the rotated journals which
+    /// are waiting for being imported, the oldest first. Rotated journals
+    /// left by an interrupted import are included.
+    public func rotate() throws -> [URL] {
+        let rotatedURL = _directoryURL.appendingPathComponent(
+            String(
+                format: "%@.%016llx-%@%@",
+                url.lastPathComponent,
+                UInt64(Date().timeIntervalSince1970 * 1000),
+                UUID().uuidString,
+                NSManagedObjectContextChangesJournal._rotatedPathExtension
+            )
+        )
+        
+        if rename(url.path, rotatedURL.path) == 0 {
+            // Waits for the appending which opened the journal before the
+            // rotation.
+            let descriptor = open(rotatedURL.path, O_RDONLY)
+            if descriptor >= 0 {
+                flock(descriptor, LOCK_EX)
+                close(descriptor)
+            }
+        } else if errno != ENOENT {
+            throw NSManagedObjectContextChangesJournalError.posixError(
+                function: "rename", code: errno
+            )
+        }
+        
+        return rotatedJournalURLs
+    }
+    
+    /// The rotated journals which are waiting for being imported, the
+    /// oldest first.
+    public var rotatedJournalURLs: [URL] {
+        let prefix = url.lastPathComponent + "."
+        
+        let fileNames = (try? FileManager.default.contentsOfDirectory(
+            atPath: _directoryURL.path
+        )) ?? []
+        
+        return fileNames
+            .filter {
+                $0.hasPrefix(prefix) && $0.hasSuffix(
+                    NSManagedObjectContextChangesJournal._rotatedPathExtension
+                )
+            }
+            .sorted()
+            .map { _directoryURL.appendingPathComponent($0) }
+    }
+    
+    /// Removes a rotated journal after its records were imported.
+    public func removeRotatedJournal(at rotatedURL: URL) throws {
+        try FileManager.default.removeItem(at: rotatedURL)
+    }
+    
+    /// Removes the records before `offset`, which shall be the end offset
+    /// of a record, from a rotated journal whose import was interrupted.
+    internal func _removeRecords(
+        before offset: Int,
+        inRotatedJournalAt rotatedURL: URL
+        ) throws
+    {
+        let data = try Data(contentsOf: rotatedURL, options: .alwaysMapped)
+        
+        guard offset < data.count else {
+            try removeRotatedJournal(at: rotatedURL)
+            return
+        }
+        
+        try data.subdata(in: offset..<data.count)
+            .write(to: rotatedURL, options: .atomic)
+    }
+    
+    // MARK: Reading
+    /// Reads records of the journal at `url` one by one, without loading
+    /// the whole journal into memory. Stops at a truncated or damaged
+    /// record.
+    public static func forEachRecord(
+        inJournalAt url: URL,
+        _ body: (_ changes: Changes) throws -> Void
+        ) throws
+    {
+        try _forEachRecord(inJournalAt: url) { (changes, _) in
+            try body(changes)
+            return true
+        }
+    }
+    
+    /// Reads records of the journal at `url` one by one, with the offset
+    /// where each record ends. Stops when `body` returns `false`.
+    internal static func _forEachRecord(
+        inJournalAt url: URL,
+        _ body: (_ changes: Changes, _ endOffset: Int) throws -> Bool
+        ) throws
+    {
+        let data: Data
+        
+        do {
+            data = try Data(contentsOf: url, options: .alwaysMapped)
+        } catch let error as NSError
+            where error.domain == NSCocoaErrorDomain
+                && error.code == NSFileReadNoSuchFileError
+        {
+            return
+        }
+        
+        var offset = 0
+        
+        while let record = _readRecord(in: data, at: offset) {
+            offset += record.length
+            if try !body(record.changes, offset) {
+                return
+            }
+        }
+        
+        #if DEBUG
+            if offset != data.count {
+                NSLog("\(self): Journal at \(url) has \(data.count - offset) bytes of damaged records.")
+            }
+        #endif
+    }
+    
+    // MARK: Encoding
+    private static func _makeRecord(with changes: Changes) -> Data {
+        var payload = Data()
+        
+        payload._appendLittleEndian(UInt32(changes.count))
+        
+        for (key, uris) in changes {
+            payload._appendString(key)
+            
+            // Object IDs of the same entity share the same URI prefix.
+            var groups = [String: [String]]()
+            var groupOrder = [String]()
+            
+            for uri in uris {
+                let prefix = uri.deletingLastPathComponent().absoluteString
+                if groups[prefix] == nil {
+                    groups[prefix] = []
+                    groupOrder.append(prefix)
+                }
+                groups[prefix]!.append(uri.lastPathComponent)
+            }
+            
+            payload._appendLittleEndian(UInt32(groupOrder.count))
+            
+            for prefix in groupOrder {
+                let lastPathComponents = groups[prefix]!
+                payload._appendString(prefix)
+                payload._appendLittleEndian(UInt32(lastPathComponents.count))
+                lastPathComponents.forEach { payload._appendString($0) }
+            }
+        }
+        
+        var record = Data(capacity: _recordHeaderLength + payload.count)
+        record._appendLittleEndian(_recordMagic)
+        record._appendLittleEndian(UInt32(payload.count))
+        record._appendLittleEndian(_checksum(of: payload))
+        record.append(payload)
+        return record
+    }
+    
+    private static func _readRecord(in data: Data, at offset: Int)
+        -> (changes: Changes, length: Int)?
+    {
+        guard data.count - offset >= _recordHeaderLength,
+            data._readLittleEndian(at: offset) == _recordMagic
+            else
+        {
+            return nil
+        }
+        
+        let payloadLength = Int(data._readLittleEndian(at: offset + 4))
+        let checksum = data._readLittleEndian(at: offset + 8)
+        let payloadStart = offset + _recordHeaderLength
+        
+        guard data.count - payloadStart >= payloadLength else {
+            return nil
+        }
+        
+        let payload = data.subdata(
+            in: payloadStart..<(payloadStart + payloadLength)
+        )
+        
+        guard _checksum(of: payload) == checksum else {
+            return nil
+        }
+        
+        var cursor = 0
+        var changes = Changes()
+        
+        guard let keyCount = payload._readLittleEndian(at: &cursor) else {
+            return nil
+        }
+        
+        for _ in 0..<keyCount {
+            guard let key = payload._readString(at: &cursor),
+                let groupCount = payload._readLittleEndian(at: &cursor)
+                else
+            {
+                return nil
+            }
+            
+            var uris = [URL]()
+            
+            for _ in 0..<groupCount {
+                guard let prefix = payload._readString(at: &cursor),
+                    let count = payload._readLittleEndian(at: &cursor)
+                    else
+                {
+                    return nil
+                }
+                
+                for _ in 0..<count {
+                    guard let lastPathComponent
+                        = payload._readString(at: &cursor),
+                        let uri = URL(string: prefix + lastPathComponent)
+                        else
+                    {
+                        return nil
+                    }
+                    uris.append(uri)
+                }
+            }
+            
+            changes[key] = uris
+        }
+        
+        return (changes, _recordHeaderLength + payloadLength)
+    }
+    
+    /// FNV-1a
+    private static func _checksum(of data: Data) -> UInt32 {
+        return data.withUnsafeBytes { (bytes: UnsafePointer<UInt8>) in
+            var hash: UInt32 = 0x811C_9DC5
+            for index in 0..<data.count {
+                hash = (hash ^ UInt32(bytes[index])) &* 0x0100_0193
+            }
+            return hash
+        }
+    }
+    
+    private func _isDescriptor(_ descriptor: Int32, referringTo url: URL)
+        -> Bool
+    {
+        var descriptorStatus = stat()
+        var pathStatus = stat()
+        
+        guard fstat(descriptor, &descriptorStatus) == 0,
+            stat(url.path, &pathStatus) == 0
+            else
+        {
+            return false
+        }
+        
+        return descriptorStatus.st_dev == pathStatus.st_dev
+            && descriptorStatus.st_ino == pathStatus.st_ino
+    }
+    
+    private var _directoryURL: URL {
+        return url.deletingLastPathComponent()
+    }
+    
+    /// "NSTJ"
+    private static let _recordMagic: UInt32 = 0x4A54_534E
+    
+    private static let _recordHeaderLength = 12
+    
+    private static let _rotatedPathExtension = ".rotated"
+}
+
+extension Data {
+    fileprivate mutating func _appendLittleEndian(_ value: UInt32) {
+        var littleEndian = value.littleEndian
+        Swift.withUnsafeBytes(of: &littleEndian) {
+            append($0.baseAddress!.assumingMemoryBound(to: UInt8.self), count: 4)
+        }
+    }
+    
+    fileprivate mutating func _appendString(_ string: String) {
+        let utf8 = Array(string.utf8)
+        _appendLittleEndian(UInt32(utf8.count))
+        append(utf8, count: utf8.count)
+    }
+    
+    fileprivate func _readLittleEndian(at offset: Int) -> UInt32 {
+        var value: UInt32 = 0
+        Swift.withUnsafeMutableBytes(of: &value) {
+            copyBytes(
+                to: $0.baseAddress!.assumingMemoryBound(to: UInt8.self),
+                from: offset..<(offset + 4)
+            )
+        }
+        return UInt32(littleEndian: value)
+    }
+    
+    fileprivate func _readLittleEndian(at cursor: inout Int) -> UInt32? {
+        guard count - cursor >= 4 else { return nil }
+        let value: UInt32 = _readLittleEndian(at: cursor)
+        cursor += 4
+        return value
+    }
+    
+    fileprivate func _readString(at cursor: inout Int) -> String? {
+        guard let length = _readLittleEndian(at: &cursor).map({ Int($0) }),
+            count - cursor >= length
+            else
+        {
+            return nil
+        }
+        
+        let string = String(
+            data: subdata(in: cursor..<(cursor + length)),
+            encoding: .utf8
+        )
+        cursor += length
+        return string
+    }
+}
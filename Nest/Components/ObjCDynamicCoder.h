@@ -10,6 +10,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class ObjCDynamicCoderMigrationPlan;
+
 /// `ObjCDynamicCoder` understands how to encode and decode its @dynamic
 /// properties.
 @interface ObjCDynamicCoder : ObjCDynamicObject<NSCoding>
@@ -40,6 +42,17 @@ NS_ASSUME_NONNULL_BEGIN
                 from:(NSInteger)fromVersion
                   to:(NSInteger)toVersion;
 
+/** Returns a declarative migration plan from `fromVersion` to `toVersion`.
+ Returns `nil` by default.
+ 
+ - Discussion: The returned plan is compiled once per version pair and
+ cached, thus this method shall return the same plan for the same version
+ pair. When a plan was returned, it takes place of
+ `+migrateValue:forKey:from:to:` for the version pair.
+ */
++ (nullable ObjCDynamicCoderMigrationPlan *)migrationPlanFrom:(NSInteger)fromVersion
+                                                           to:(NSInteger)toVersion;
+
 /** Returns a fallback value for a non-migration decoding a property named
  `key`. */
 + (nullable id)defaultValueForKey:(NSString *)key;
@@ -51,4 +64,59 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)encodeWithCoder:(NSCoder *)aCoder;
 @end
 
+typedef id _Nullable (^ObjCDynamicCoderMigrationConversion)(id _Nullable value);
+
+/** `ObjCDynamicCoderMigrationPlan` declares how the values archived by an
+ old version of an `ObjCDynamicCoder` subclass migrate to the current one.
+ All the keys are names of the current @dynamic properties.
+ 
+ - Discussion: Steps of a property apply in the order of rename, drop,
+ convert and default. Properties without any step are decoded as is.
+ */
+@interface ObjCDynamicCoderMigrationPlan : NSObject
+/// Decodes the property named `key` from the value archived as `oldKey`.
+- (void)renameKey:(NSString *)oldKey toKey:(NSString *)key;
+
+/// Omits the archived value of the property named `key`.
+- (void)dropKey:(NSString *)key;
+
+/// Converts the decoded value of the property named `key`.
+- (void)convertValueForKey:(NSString *)key
+                usingBlock:(ObjCDynamicCoderMigrationConversion)conversion;
+
+/// Offers a value when the property named `key` ends with a nil value.
+- (void)setDefaultValue:(id)value forKey:(NSString *)key;
+@end
+
+@interface ObjCDynamicCoder (ColumnarCoding)
+/** Encodes a homogeneous collection of instances of the receiver column by
+ column.
+ 
+ @param     objects         The instances to encode. All of them shall be
+ instances of exactly the receiver.
+ 
+ @param     coder           The keyed coder to encode with.
+ 
+ @param     key             The key prefix of the encoded columns.
+ 
+ - Discussion: Each @dynamic property is encoded as one column. Scalar and
+ struct (without pointers) properties are stored raw as one contiguous
+ buffer in host byte order, properties of object type are stored as one
+ array and all the other properties fall back to their registered coding
+ call-backs.
+ */
++ (void)encodeObjects:(NSArray<__kindof ObjCDynamicCoder *> *)objects
+            withCoder:(NSCoder *)coder
+               forKey:(NSString *)key;
+
+/** Decodes a homogeneous collection of instances of the receiver which was
+ encoded with `+encodeObjects:withCoder:forKey:`.
+ 
+ - Discussion: Returns `nil` when there is no collection for `key`, the
+ columns are inconsistent, or any value migration was failed.
+ */
++ (nullable NSArray<__kindof ObjCDynamicCoder *> *)decodeObjectsWithCoder:(NSCoder *)decoder
+                                                                    forKey:(NSString *)key;
+@end
+
 NS_ASSUME_NONNULL_END
@@ -13,8 +13,145 @@
 
 #import "ObjCDynamicCoder.h"
 
+@import ObjectiveC;
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+#pragma mark - Types
+typedef NS_ENUM(NSInteger, ObjCDynamicCoderColumnKind) {
+    /// Values are `NSNumber`s, stored raw.
+    ObjCDynamicCoderColumnKindScalar,
+    /// Values are `NSValue`s of structs without pointers, stored raw.
+    ObjCDynamicCoderColumnKindStruct,
+    /// Values are objects, stored as one array.
+    ObjCDynamicCoderColumnKindObject,
+    /// Values are coded with the registered coding call-backs.
+    ObjCDynamicCoderColumnKindCallBack,
+};
+
+typedef struct _ObjCDynamicCoderPropertyPlan {
+    __unsafe_unretained NSString * name;
+    const char * typeEncoding;
+    ObjCDynamicCoderColumnKind columnKind;
+    NSUInteger size;
+    ObjCDynamicCodingDecodeCallBack decodeCallBack;
+    ObjCDynamicCodingEncodeCallBack encodeCallBack;
+} ObjCDynamicCoderPropertyPlan;
+
+/// Describes all the @dynamic properties of an `ObjCDynamicCoder`
+/// subclass. Created once per class and never released.
+typedef struct _ObjCDynamicCoderClassPlan {
+    NSUInteger propertyCount;
+    ObjCDynamicCoderPropertyPlan * properties;
+    /// The list of compiled migrations. Read without any lock and prepended
+    /// under `kObjCDynamicCoderMigrationLock`.
+    _Atomic(const struct _ObjCDynamicCoderMigration *) migrations;
+} ObjCDynamicCoderClassPlan;
+
+/// An entry of the class plan table. Immutable once published.
+typedef struct _ObjCDynamicCoderClassPlanEntry {
+    __unsafe_unretained Class ownerClass;
+    const ObjCDynamicCoderClassPlan * plan;
+    const struct _ObjCDynamicCoderClassPlanEntry * next;
+} ObjCDynamicCoderClassPlanEntry;
+
+typedef struct _ObjCDynamicCoderPropertyMigration {
+    /// The key of the archived value. `nil` when the value was dropped.
+    __unsafe_unretained NSString * archivedKey;
+    __unsafe_unretained ObjCDynamicCoderMigrationConversion conversion;
+    __unsafe_unretained id defaultValue;
+} ObjCDynamicCoderPropertyMigration;
+
+/// A compiled `ObjCDynamicCoderMigrationPlan`, indexed in the same order of
+/// properties of its class plan. Created once per version pair and never
+/// released.
+typedef struct _ObjCDynamicCoderMigration {
+    NSInteger fromVersion;
+    NSInteger toVersion;
+    /// `NULL` when the class offers no plan for the version pair, which
+    /// falls back to `+migrateValue:forKey:from:to:`.
+    ObjCDynamicCoderPropertyMigration * properties;
+    const struct _ObjCDynamicCoderMigration * next;
+} ObjCDynamicCoderMigration;
+
+/// Describes how a decoding resolves values.
+typedef struct _ObjCDynamicCoderDecodeContext {
+    __unsafe_unretained Class ownerClass;
+    const ObjCDynamicCoderClassPlan * plan;
+    BOOL shouldMigrate;
+    NSInteger fromVersion;
+    NSInteger toVersion;
+    const ObjCDynamicCoderMigration * migration;
+} ObjCDynamicCoderDecodeContext;
+
+@interface ObjCDynamicCoderMigrationPlan()
+@property (nonatomic, readonly, strong) NSMutableDictionary<NSString *, NSString *> * renamedKeys;
+@property (nonatomic, readonly, strong) NSMutableSet<NSString *> * droppedKeys;
+@property (nonatomic, readonly, strong) NSMutableDictionary<NSString *, ObjCDynamicCoderMigrationConversion> * conversions;
+@property (nonatomic, readonly, strong) NSMutableDictionary<NSString *, id> * defaultValues;
+@end
+
+/// Wraps a value of a call-back column so that the value is coded in its
+/// own keyed scope, where the key is exactly the property name which the
+/// coding call-backs expect.
+@interface _ObjCDynamicCoderColumnCell : NSObject<NSCoding>
+@property (nonatomic, readonly, unsafe_unretained) Class ownerClass;
+@property (nonatomic, readonly, copy) NSString * propertyName;
+@property (nonatomic, readonly, strong, nullable) id value;
+- (instancetype)initWithOwnerClass:(Class)ownerClass
+                      propertyName:(NSString *)propertyName
+                             value:(nullable id)value;
+@end
+
+#pragma mark - Function Prototypes
+static const ObjCDynamicCoderClassPlan * ObjCDynamicCoderGetClassPlan(Class);
+
+static ObjCDynamicCoderClassPlan * ObjCDynamicCoderClassPlanCreate(Class);
+
+static ObjCDynamicCoderColumnKind ObjCDynamicCoderGetColumnKind(const char *, NSUInteger *);
+
+static BOOL ObjCDynamicCoderWriteRawValue(const ObjCDynamicCoderPropertyPlan *, id, void *);
+
+static id ObjCDynamicCoderReadRawValue(const ObjCDynamicCoderPropertyPlan *, const void *);
+
+static const ObjCDynamicCoderMigration * ObjCDynamicCoderGetMigration(Class, const ObjCDynamicCoderClassPlan *, NSInteger, NSInteger);
+
+static ObjCDynamicCoderMigration * ObjCDynamicCoderMigrationCreate(Class, const ObjCDynamicCoderClassPlan *, NSInteger, NSInteger);
+
+static ObjCDynamicCoderDecodeContext ObjCDynamicCoderDecodeContextMake(Class, NSInteger);
+
+static NSString * ObjCDynamicCoderGetArchivedKey(const ObjCDynamicCoderDecodeContext *, NSUInteger);
+
+static id ObjCDynamicCoderResolveDecodedValue(const ObjCDynamicCoderDecodeContext *, NSUInteger, id, NSString * __autoreleasing *, BOOL *);
+
+static BOOL ObjCDynamicCoderStoreDecodedValue(const ObjCDynamicCoderDecodeContext *, NSUInteger, id, NSMutableDictionary<NSString *, id> *);
+
+#pragma mark - Variables
+#define kObjCDynamicCoderClassPlanBucketCount 64
+
+/// Buckets of the class plan table. Read without any lock and prepended
+/// under `kObjCDynamicCoderPlanLock`.
+static _Atomic(const ObjCDynamicCoderClassPlanEntry *) kObjCDynamicCoderClassPlanBuckets[kObjCDynamicCoderClassPlanBucketCount];
+
+static pthread_mutex_t kObjCDynamicCoderPlanLock = PTHREAD_MUTEX_INITIALIZER;
+
+/// Recursive since compiling a migration calls out to the class.
+static pthread_mutex_t kObjCDynamicCoderMigrationLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER;
+
+/// The property whose call-back column is being decoded on the current
+/// thread. Cells of a renamed column are archived with the old property
+/// name but shall be decoded with the call-back of this property.
+static __thread const ObjCDynamicCoderPropertyPlan * kObjCDynamicCoderDecodingColumnProperty = NULL;
+
 static NSString *  kObjCDynamicCoderVersionKey = @"com.WeZZard.Nest.ObjCDynamicCoder.version";
 
+static NSString *  kObjCDynamicCoderColumnCountSuffix = @".com.WeZZard.Nest.ObjCDynamicCoder.count";
+
+static NSString *  kObjCDynamicCoderColumnVersionSuffix = @".com.WeZZard.Nest.ObjCDynamicCoder.version";
+
+static NSString *  kObjCDynamicCoderColumnPresenceSuffix = @".com.WeZZard.Nest.ObjCDynamicCoder.presence";
+
 @implementation ObjCDynamicCoder
 + (NSInteger)version {
     return 0;
@@ -47,73 +184,40 @@ static NSString *  kObjCDynamicCoderVersionKey = @"com.WeZZard.Nest.ObjCDynamicC
     self = [super init];
     
     if (self) {
-        NSInteger classVersion = [[self class] version];
-        
         NSInteger binaryVersion
         = [aDecoder decodeIntegerForKey:kObjCDynamicCoderVersionKey];
         
-        BOOL shouldMigrate = classVersion != binaryVersion;
+        ObjCDynamicCoderDecodeContext context
+        = ObjCDynamicCoderDecodeContextMake([self class], binaryVersion);
         
         BOOL isWholeMigrationSucceeded = YES;
         
-        Class inspectedClass = [self class];
-        
-        Class searchingTerminateClass = [ObjCDynamicCoder class];
-        
-        while (inspectedClass != searchingTerminateClass) {
+        for (NSUInteger index = 0; index < context.plan -> propertyCount; index ++) {
+            const ObjCDynamicCoderPropertyPlan * property = &context.plan -> properties[index];
             
-            unsigned int propertyCount = 0;
+            NSString * archivedKey = ObjCDynamicCoderGetArchivedKey(&context, index);
             
-            objc_property_t * propertyList
-            = class_copyPropertyList(inspectedClass, &propertyCount);
+            id value = nil;
             
-            for (unsigned int index = 0; index < propertyCount; index ++) {
-                objc_property_t property = propertyList[index];
-                
-                if (property_copyAttributeValue(property, "D")) {
-                    const char * rawPropertyName = property_getName(property);
-                    
-                    NSString * propertyName
-                    = [NSString stringWithCString:rawPropertyName
-                                         encoding:NSUTF8StringEncoding];
-                    
-                    ObjCDynamicCodingDecodeCallBack decode
-                    = ObjCDynamicCodingGetDecodeCallBackForPropertyName([self class], propertyName);
-                    
-                    id value = (* decode)([self class], aDecoder, propertyName);
-                    
-                    if (shouldMigrate) {
-                        BOOL isValueMigrationSucceeded
-                        = [[self class] migrateValue:&value
-                                              forKey:&propertyName
-                                                from:binaryVersion
-                                                  to:classVersion];
-                        
-                        isWholeMigrationSucceeded
-                        = isWholeMigrationSucceeded && isValueMigrationSucceeded;
-                    } else {
-                        if (value == nil) {
-                            id defaultValue
-                            = [[self class] defaultValueForKey:propertyName];
-                            
-                            if (defaultValue != nil) {
-                                value = defaultValue;
-                            }
-                        }
-                    }
-                    
-                    if (propertyName != nil) {
-                        [self setValue:value forKey:propertyName];
-                    }
-                }
+            if (archivedKey != nil) {
+                value = (* property -> decodeCallBack)(context.ownerClass, aDecoder, archivedKey);
             }
             
-            free(propertyList);
+            NSString * propertyName = property -> name;
+            
+            BOOL isValueMigrationSucceeded = YES;
+            
+            value = ObjCDynamicCoderResolveDecodedValue(&context, index, value, &propertyName, &isValueMigrationSucceeded);
+            
+            isWholeMigrationSucceeded
+            = isWholeMigrationSucceeded && isValueMigrationSucceeded;
             
-            inspectedClass = [inspectedClass superclass];
+            if (propertyName != nil) {
+                [self setValue:value forKey:propertyName];
+            }
         }
         
-        if (shouldMigrate && !isWholeMigrationSucceeded) {
+        if (context.shouldMigrate && !isWholeMigrationSucceeded) {
             return nil;
         }
     }
@@ -121,6 +225,12 @@ static NSString *  kObjCDynamicCoderVersionKey = @"com.WeZZard.Nest.ObjCDynamicC
     return self;
 }
 
++ (ObjCDynamicCoderMigrationPlan *)migrationPlanFrom:(NSInteger)fromVersion
+                                                  to:(NSInteger)toVersion
+{
+    return nil;
+}
+
 - (void)encodeWithCoder:(NSCoder *)coder {
     [coder encodeInteger:[[self class] version] forKey:kObjCDynamicCoderVersionKey];
     
@@ -134,3 +244,742 @@ static NSString *  kObjCDynamicCoderVersionKey = @"com.WeZZard.Nest.ObjCDynamicC
     }
 }
 @end
+
+@implementation ObjCDynamicCoder (ColumnarCoding)
++ (void)encodeObjects:(NSArray<__kindof ObjCDynamicCoder *> *)objects
+            withCoder:(NSCoder *)coder
+               forKey:(NSString *)key
+{
+    NSAssert(coder.allowsKeyedCoding, @"Columnar coding requires a keyed coder.");
+    
+    const ObjCDynamicCoderClassPlan * plan = ObjCDynamicCoderGetClassPlan(self);
+    
+    NSUInteger count = objects.count;
+    
+#if DEBUG
+    for (id object in objects) {
+        NSAssert([object class] == self, @"Columnar coding requires all the objects to be instances of %@ but got an instance of %@.", NSStringFromClass(self), NSStringFromClass([object class]));
+    }
+#endif
+    
+    [coder encodeInteger:[self version] forKey:[key stringByAppendingString:kObjCDynamicCoderColumnVersionSuffix]];
+    [coder encodeInteger:(NSInteger)count forKey:[key stringByAppendingString:kObjCDynamicCoderColumnCountSuffix]];
+    
+    for (NSUInteger propertyIndex = 0; propertyIndex < plan -> propertyCount; propertyIndex ++) {
+        const ObjCDynamicCoderPropertyPlan * property = &plan -> properties[propertyIndex];
+        
+        NSString * columnKey = [key stringByAppendingFormat:@".%@", property -> name];
+        
+        switch (property -> columnKind) {
+            case ObjCDynamicCoderColumnKindScalar:
+            case ObjCDynamicCoderColumnKindStruct: {
+                NSMutableData * column = [[NSMutableData alloc] initWithLength:count * property -> size];
+                uint8_t * bytes = column.mutableBytes;
+                
+                // Only encoded when there are absent values.
+                NSMutableData * presence = nil;
+                
+                for (NSUInteger index = 0; index < count; index ++) {
+                    ObjCDynamicCoder * object = objects[index];
+                    id value = [object primitiveValueForKey:property -> name];
+                    
+                    if (!ObjCDynamicCoderWriteRawValue(property, value, bytes + index * property -> size)) {
+                        if (presence == nil) {
+                            presence = [[NSMutableData alloc] initWithLength:(count + 7) / 8];
+                            memset(presence.mutableBytes, 0xFF, presence.length);
+                        }
+                        ((uint8_t *)presence.mutableBytes)[index / 8] &= ~(1 << (index % 8));
+                    }
+                }
+                
+                [coder encodeBytes:column.bytes length:column.length forKey:columnKey];
+                
+                if (presence != nil) {
+                    [coder encodeBytes:presence.bytes length:presence.length forKey:[columnKey stringByAppendingString:kObjCDynamicCoderColumnPresenceSuffix]];
+                }
+                break;
+            }
+            case ObjCDynamicCoderColumnKindObject: {
+                NSMutableArray * column = [[NSMutableArray alloc] initWithCapacity:count];
+                
+                for (ObjCDynamicCoder * object in objects) {
+                    id value = [object primitiveValueForKey:property -> name];
+                    [column addObject:value ?: [NSNull null]];
+                }
+                
+                [coder encodeObject:column forKey:columnKey];
+                break;
+            }
+            case ObjCDynamicCoderColumnKindCallBack: {
+                NSMutableArray * column = [[NSMutableArray alloc] initWithCapacity:count];
+                
+                for (ObjCDynamicCoder * object in objects) {
+                    id value = [object primitiveValueForKey:property -> name];
+                    if (value == nil) {
+                        [column addObject:[NSNull null]];
+                    } else {
+                        [column addObject:[[_ObjCDynamicCoderColumnCell alloc] initWithOwnerClass:self propertyName:property -> name value:value]];
+                    }
+                }
+                
+                [coder encodeObject:column forKey:columnKey];
+                break;
+            }
+        }
+    }
+}
+
++ (NSArray<__kindof ObjCDynamicCoder *> *)decodeObjectsWithCoder:(NSCoder *)decoder
+                                                           forKey:(NSString *)key
+{
+    NSString * countKey = [key stringByAppendingString:kObjCDynamicCoderColumnCountSuffix];
+    
+    if (![decoder containsValueForKey:countKey]) {
+        return nil;
+    }
+    
+    NSInteger signedCount = [decoder decodeIntegerForKey:countKey];
+    
+    if (signedCount < 0) {
+        return nil;
+    }
+    
+    NSUInteger count = (NSUInteger)signedCount;
+    
+    NSInteger binaryVersion
+    = [decoder decodeIntegerForKey:[key stringByAppendingString:kObjCDynamicCoderColumnVersionSuffix]];
+    
+    ObjCDynamicCoderDecodeContext context
+    = ObjCDynamicCoderDecodeContextMake(self, binaryVersion);
+    
+    const ObjCDynamicCoderClassPlan * plan = context.plan;
+    
+    BOOL isWholeMigrationSucceeded = YES;
+    
+    NSMutableArray<NSMutableDictionary<NSString *, id> *> * storages
+    = [[NSMutableArray alloc] initWithCapacity:count];
+    
+    for (NSUInteger index = 0; index < count; index ++) {
+        [storages addObject:[[NSMutableDictionary alloc] initWithCapacity:plan -> propertyCount]];
+    }
+    
+    for (NSUInteger propertyIndex = 0; propertyIndex < plan -> propertyCount; propertyIndex ++) {
+        const ObjCDynamicCoderPropertyPlan * property = &plan -> properties[propertyIndex];
+        
+        // Renamed columns are read with the layout of the current property.
+        NSString * archivedKey = ObjCDynamicCoderGetArchivedKey(&context, propertyIndex);
+        
+        NSString * columnKey = [key stringByAppendingFormat:@".%@", archivedKey];
+        
+        switch (property -> columnKind) {
+            case ObjCDynamicCoderColumnKindScalar:
+            case ObjCDynamicCoderColumnKindStruct: {
+                NSUInteger length = 0;
+                const uint8_t * bytes = NULL;
+                
+                if (archivedKey != nil && [decoder containsValueForKey:columnKey]) {
+                    bytes = [decoder decodeBytesForKey:columnKey returnedLength:&length];
+                    
+                    if (length != count * property -> size) {
+                        return nil;
+                    }
+                }
+                
+                NSUInteger presenceLength = 0;
+                const uint8_t * presence = [decoder decodeBytesForKey:[columnKey stringByAppendingString:kObjCDynamicCoderColumnPresenceSuffix] returnedLength:&presenceLength];
+                
+                if (presence != NULL && presenceLength < (count + 7) / 8) {
+                    return nil;
+                }
+                
+                for (NSUInteger index = 0; index < count; index ++) {
+                    id value = nil;
+                    
+                    if (bytes != NULL && (presence == NULL || (presence[index / 8] & (1 << (index % 8))) != 0)) {
+                        value = ObjCDynamicCoderReadRawValue(property, bytes + index * property -> size);
+                    }
+                    
+                    isWholeMigrationSucceeded
+                    = ObjCDynamicCoderStoreDecodedValue(&context, propertyIndex, value, storages[index])
+                    && isWholeMigrationSucceeded;
+                }
+                break;
+            }
+            case ObjCDynamicCoderColumnKindObject:
+            case ObjCDynamicCoderColumnKindCallBack: {
+                NSArray * column = nil;
+                
+                if (archivedKey != nil) {
+                    const ObjCDynamicCoderPropertyPlan * decodingColumnProperty
+                    = kObjCDynamicCoderDecodingColumnProperty;
+                    
+                    kObjCDynamicCoderDecodingColumnProperty = property;
+                    
+                    @try {
+                        column = [decoder decodeObjectForKey:columnKey];
+                    } @finally {
+                        kObjCDynamicCoderDecodingColumnProperty = decodingColumnProperty;
+                    }
+                }
+                
+                if (column != nil && (![column isKindOfClass:[NSArray class]] || column.count != count)) {
+                    return nil;
+                }
+                
+                NSNull * null = [NSNull null];
+                
+                for (NSUInteger index = 0; index < count; index ++) {
+                    id value = column == nil ? null : column[index];
+                    
+                    if (value == null) {
+                        value = nil;
+                    } else if (property -> columnKind == ObjCDynamicCoderColumnKindCallBack) {
+                        if (![value isKindOfClass:[_ObjCDynamicCoderColumnCell class]]) {
+                            return nil;
+                        }
+                        value = [(_ObjCDynamicCoderColumnCell *)value value];
+                    }
+                    
+                    isWholeMigrationSucceeded
+                    = ObjCDynamicCoderStoreDecodedValue(&context, propertyIndex, value, storages[index])
+                    && isWholeMigrationSucceeded;
+                }
+                break;
+            }
+        }
+    }
+    
+    if (context.shouldMigrate && !isWholeMigrationSucceeded) {
+        return nil;
+    }
+    
+    NSMutableArray<ObjCDynamicCoder *> * objects = [[NSMutableArray alloc] initWithCapacity:count];
+    
+    NSNull * null = [NSNull null];
+    
+    // Goes through the dynamic accessors like `-initWithCoder:` does.
+    for (NSMutableDictionary<NSString *, id> * storage in storages) {
+        ObjCDynamicCoder * object = [[self alloc] init];
+        for (NSString * propertyName in storage) {
+            id value = storage[propertyName];
+            [object setValue:(value == null ? nil : value) forKey:propertyName];
+        }
+        [objects addObject:object];
+    }
+    
+    return objects;
+}
+@end
+
+@implementation ObjCDynamicCoderMigrationPlan
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _renamedKeys = [[NSMutableDictionary alloc] init];
+        _droppedKeys = [[NSMutableSet alloc] init];
+        _conversions = [[NSMutableDictionary alloc] init];
+        _defaultValues = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (void)renameKey:(NSString *)oldKey toKey:(NSString *)key {
+    _renamedKeys[key] = [oldKey copy];
+}
+
+- (void)dropKey:(NSString *)key {
+    [_droppedKeys addObject:key];
+}
+
+- (void)convertValueForKey:(NSString *)key
+                usingBlock:(ObjCDynamicCoderMigrationConversion)conversion
+{
+    _conversions[key] = [conversion copy];
+}
+
+- (void)setDefaultValue:(id)value forKey:(NSString *)key {
+    _defaultValues[key] = value;
+}
+@end
+
+@implementation _ObjCDynamicCoderColumnCell
+- (instancetype)initWithOwnerClass:(Class)ownerClass
+                      propertyName:(NSString *)propertyName
+                             value:(id)value
+{
+    self = [super init];
+    if (self) {
+        _ownerClass = ownerClass;
+        _propertyName = [propertyName copy];
+        _value = value;
+    }
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super init];
+    if (self) {
+        _ownerClass = NSClassFromString([aDecoder decodeObjectForKey:@"ownerClass"]);
+        _propertyName = [aDecoder decodeObjectForKey:@"propertyName"];
+        
+        if (_ownerClass == nil || _propertyName == nil) {
+            return nil;
+        }
+        
+        const ObjCDynamicCoderPropertyPlan * property
+        = kObjCDynamicCoderDecodingColumnProperty;
+        
+        ObjCDynamicCodingDecodeCallBack decode = property != NULL
+        ? property -> decodeCallBack
+        : ObjCDynamicCodingGetDecodeCallBackForPropertyName(_ownerClass, _propertyName);
+        
+        _value = (* decode)(_ownerClass, aDecoder, _propertyName);
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [aCoder encodeObject:NSStringFromClass(_ownerClass) forKey:@"ownerClass"];
+    [aCoder encodeObject:_propertyName forKey:@"propertyName"];
+    
+    ObjCDynamicCodingEncodeCallBack encode
+    = ObjCDynamicCodingGetEncodeCallBackForPropertyName(_ownerClass, _propertyName);
+    
+    (* encode)(_ownerClass, aCoder, _propertyName, _value);
+}
+@end
+
+#pragma mark - Function Implementations
+#pragma mark Class Plan
+const ObjCDynamicCoderClassPlan * ObjCDynamicCoderGetClassPlan(Class aClass) {
+    _Atomic(const ObjCDynamicCoderClassPlanEntry *) * bucket
+    = &kObjCDynamicCoderClassPlanBuckets[((uintptr_t)(__bridge void *)aClass >> 4) % kObjCDynamicCoderClassPlanBucketCount];
+    
+    const ObjCDynamicCoderClassPlanEntry * head
+    = atomic_load_explicit(bucket, memory_order_acquire);
+    
+    for (const ObjCDynamicCoderClassPlanEntry * entry = head; entry != NULL; entry = entry -> next) {
+        if (entry -> ownerClass == aClass) {
+            return entry -> plan;
+        }
+    }
+    
+    pthread_mutex_lock(&kObjCDynamicCoderPlanLock);
+    
+    // Entries prepended by other threads since the lock-free lookup.
+    const ObjCDynamicCoderClassPlanEntry * lockedHead
+    = atomic_load_explicit(bucket, memory_order_relaxed);
+    
+    const ObjCDynamicCoderClassPlan * plan = NULL;
+    
+    for (const ObjCDynamicCoderClassPlanEntry * entry = lockedHead; entry != head; entry = entry -> next) {
+        if (entry -> ownerClass == aClass) {
+            plan = entry -> plan;
+            break;
+        }
+    }
+    
+    if (plan == NULL) {
+        plan = ObjCDynamicCoderClassPlanCreate(aClass);
+        
+        ObjCDynamicCoderClassPlanEntry * entry
+        = malloc(sizeof(ObjCDynamicCoderClassPlanEntry));
+        
+        * entry = (ObjCDynamicCoderClassPlanEntry){aClass, plan, lockedHead};
+        
+        atomic_store_explicit(bucket, entry, memory_order_release);
+    }
+    
+    pthread_mutex_unlock(&kObjCDynamicCoderPlanLock);
+    
+    return plan;
+}
+
+ObjCDynamicCoderClassPlan * ObjCDynamicCoderClassPlanCreate(Class aClass) {
+    ObjCDynamicCoderClassPlan * plan = malloc(sizeof(ObjCDynamicCoderClassPlan));
+    
+    NSUInteger capacity = 8;
+    
+    plan -> propertyCount = 0;
+    plan -> properties = malloc(sizeof(ObjCDynamicCoderPropertyPlan) * capacity);
+    atomic_init(&plan -> migrations, NULL);
+    
+    NSMutableSet<NSString *> * visitedPropertyNames = [[NSMutableSet alloc] init];
+    
+    Class inspectedClass = aClass;
+    
+    Class searchingTerminateClass = [ObjCDynamicCoder class];
+    
+    while (inspectedClass != searchingTerminateClass && inspectedClass != Nil) {
+        unsigned int propertyCount = 0;
+        
+        objc_property_t * propertyList
+        = class_copyPropertyList(inspectedClass, &propertyCount);
+        
+        for (unsigned int index = 0; index < propertyCount; index ++) {
+            objc_property_t property = propertyList[index];
+            
+            char * isDynamic = property_copyAttributeValue(property, "D");
+            
+            if (isDynamic == NULL) {
+                continue;
+            }
+            
+            free(isDynamic);
+            
+            NSString * propertyName
+            = [NSString stringWithCString:property_getName(property)
+                                 encoding:NSUTF8StringEncoding];
+            
+            // Properties redeclared in subclasses are inspected only once.
+            if ([visitedPropertyNames containsObject:propertyName]) {
+                continue;
+            }
+            
+            [visitedPropertyNames addObject:propertyName];
+            
+            if (plan -> propertyCount == capacity) {
+                capacity *= 2;
+                plan -> properties = realloc(plan -> properties, sizeof(ObjCDynamicCoderPropertyPlan) * capacity);
+            }
+            
+            const char * typeEncoding = property_copyAttributeValue(property, "T");
+            
+            NSUInteger size = 0;
+            
+            ObjCDynamicCoderColumnKind columnKind
+            = ObjCDynamicCoderGetColumnKind(typeEncoding, &size);
+            
+            plan -> properties[plan -> propertyCount] = (ObjCDynamicCoderPropertyPlan){
+                (__bridge NSString *)CFBridgingRetain(propertyName),
+                typeEncoding,
+                columnKind,
+                size,
+                ObjCDynamicCodingGetDecodeCallBackForPropertyName(aClass, propertyName),
+                ObjCDynamicCodingGetEncodeCallBackForPropertyName(aClass, propertyName)
+            };
+            
+            plan -> propertyCount += 1;
+        }
+        
+        free(propertyList);
+        
+        inspectedClass = [inspectedClass superclass];
+    }
+    
+    return plan;
+}
+
+ObjCDynamicCoderColumnKind ObjCDynamicCoderGetColumnKind(
+    const char * typeEncoding,
+    NSUInteger * size
+    )
+{
+    const char * type = typeEncoding;
+    
+    switch (* type) {
+        case 'c': case 'i': case 's': case 'l': case 'q':
+        case 'C': case 'I': case 'S': case 'L': case 'Q':
+        case 'B': case 'f': case 'd':
+            NSGetSizeAndAlignment(type, size, NULL);
+            return ObjCDynamicCoderColumnKindScalar;
+        case '{':
+            // Structs with pointers, objects or unions cannot be stored raw.
+            if (strpbrk(type, "@^*:#?(") == NULL) {
+                NSGetSizeAndAlignment(type, size, NULL);
+                return ObjCDynamicCoderColumnKindStruct;
+            }
+            return ObjCDynamicCoderColumnKindCallBack;
+        case '@':
+        case ':':
+            return ObjCDynamicCoderColumnKindObject;
+        default:
+            return ObjCDynamicCoderColumnKindCallBack;
+    }
+}
+
+#pragma mark Raw Values
+BOOL ObjCDynamicCoderWriteRawValue(
+    const ObjCDynamicCoderPropertyPlan * property,
+    id value,
+    void * slot
+    )
+{
+    if (property -> columnKind == ObjCDynamicCoderColumnKindStruct) {
+        if (![value isKindOfClass:[NSValue class]]) {
+            return NO;
+        }
+        
+        NSUInteger valueSize = 0;
+        NSGetSizeAndAlignment([value objCType], &valueSize, NULL);
+        
+        if (valueSize != property -> size) {
+            return NO;
+        }
+        
+        [value getValue:slot];
+        return YES;
+    }
+    
+    if (![value isKindOfClass:[NSNumber class]]) {
+        return NO;
+    }
+    
+    NSNumber * number = value;
+    
+    switch (property -> typeEncoding[0]) {
+        case 'c': * (char *)slot = [number charValue];                              break;
+        case 'i': * (int *)slot = [number intValue];                                break;
+        case 's': * (short *)slot = [number shortValue];                            break;
+        case 'l': * (long *)slot = [number longValue];                              break;
+        case 'q': * (long long *)slot = [number longLongValue];                     break;
+        case 'C': * (unsigned char *)slot = [number unsignedCharValue];             break;
+        case 'I': * (unsigned int *)slot = [number unsignedIntValue];               break;
+        case 'S': * (unsigned short *)slot = [number unsignedShortValue];           break;
+        case 'L': * (unsigned long *)slot = [number unsignedLongValue];             break;
+        case 'Q': * (unsigned long long *)slot = [number unsignedLongLongValue];    break;
+        case 'B': * (bool *)slot = [number boolValue];                              break;
+        case 'f': * (float *)slot = [number floatValue];                            break;
+        case 'd': * (double *)slot = [number doubleValue];                          break;
+        default: return NO;
+    }
+    
+    return YES;
+}
+
+id ObjCDynamicCoderReadRawValue(
+    const ObjCDynamicCoderPropertyPlan * property,
+    const void * slot
+    )
+{
+    if (property -> columnKind == ObjCDynamicCoderColumnKindStruct) {
+        return [NSValue valueWithBytes:slot objCType:property -> typeEncoding];
+    }
+    
+    switch (property -> typeEncoding[0]) {
+        case 'c': return @(* (const char *)slot);
+        case 'i': return @(* (const int *)slot);
+        case 's': return @(* (const short *)slot);
+        case 'l': return @(* (const long *)slot);
+        case 'q': return @(* (const long long *)slot);
+        case 'C': return @(* (const unsigned char *)slot);
+        case 'I': return @(* (const unsigned int *)slot);
+        case 'S': return @(* (const unsigned short *)slot);
+        case 'L': return @(* (const unsigned long *)slot);
+        case 'Q': return @(* (const unsigned long long *)slot);
+        case 'B': return @(* (const bool *)slot);
+        case 'f': return @(* (const float *)slot);
+        case 'd': return @(* (const double *)slot);
+        default: return nil;
+    }
+}
+
+#pragma mark Decoding
+ObjCDynamicCoderDecodeContext ObjCDynamicCoderDecodeContextMake(
+    Class aClass,
+    NSInteger binaryVersion
+    )
+{
+    NSInteger classVersion = [aClass version];
+    
+    const ObjCDynamicCoderClassPlan * plan = ObjCDynamicCoderGetClassPlan(aClass);
+    
+    BOOL shouldMigrate = classVersion != binaryVersion;
+    
+    const ObjCDynamicCoderMigration * migration = shouldMigrate
+    ? ObjCDynamicCoderGetMigration(aClass, plan, binaryVersion, classVersion)
+    : NULL;
+    
+    return (ObjCDynamicCoderDecodeContext){
+        aClass,
+        plan,
+        shouldMigrate,
+        binaryVersion,
+        classVersion,
+        migration
+    };
+}
+
+NSString * ObjCDynamicCoderGetArchivedKey(
+    const ObjCDynamicCoderDecodeContext * context,
+    NSUInteger propertyIndex
+    )
+{
+    if (context -> migration != NULL && context -> migration -> properties != NULL) {
+        return context -> migration -> properties[propertyIndex].archivedKey;
+    }
+    return context -> plan -> properties[propertyIndex].name;
+}
+
+id ObjCDynamicCoderResolveDecodedValue(
+    const ObjCDynamicCoderDecodeContext * context,
+    NSUInteger propertyIndex,
+    id value,
+    NSString * __autoreleasing * key,
+    BOOL * succeeded
+    )
+{
+    * succeeded = YES;
+    
+    if (!context -> shouldMigrate) {
+        if (value == nil) {
+            value = [context -> ownerClass defaultValueForKey:* key];
+        }
+        return value;
+    }
+    
+    if (context -> migration -> properties == NULL) {
+        * succeeded = [context -> ownerClass migrateValue:&value
+                                                   forKey:key
+                                                     from:context -> fromVersion
+                                                       to:context -> toVersion];
+        return value;
+    }
+    
+    const ObjCDynamicCoderPropertyPlan * property
+    = &context -> plan -> properties[propertyIndex];
+    
+    const ObjCDynamicCoderPropertyMigration * migration
+    = &context -> migration -> properties[propertyIndex];
+    
+    // Values decoded from renamed keys by the default decode call-back are
+    // left as `NSData`.
+    if (property -> columnKind == ObjCDynamicCoderColumnKindStruct
+        && [value isKindOfClass:[NSData class]]
+        && [value length] == property -> size)
+    {
+        value = [NSValue valueWithBytes:[value bytes]
+                               objCType:property -> typeEncoding];
+    }
+    
+    if (migration -> conversion != nil) {
+        value = migration -> conversion(value);
+    }
+    
+    if (value == nil) {
+        value = migration -> defaultValue;
+    }
+    
+    return value;
+}
+
+BOOL ObjCDynamicCoderStoreDecodedValue(
+    const ObjCDynamicCoderDecodeContext * context,
+    NSUInteger propertyIndex,
+    id value,
+    NSMutableDictionary<NSString *, id> * storage
+    )
+{
+    NSString * propertyName = context -> plan -> properties[propertyIndex].name;
+    
+    BOOL isValueMigrationSucceeded = YES;
+    
+    value = ObjCDynamicCoderResolveDecodedValue(context, propertyIndex, value, &propertyName, &isValueMigrationSucceeded);
+    
+    // Nil values are kept as `NSNull` to be set like `-initWithCoder:` does.
+    if (propertyName != nil) {
+        storage[propertyName] = value ?: [NSNull null];
+    }
+    
+    return isValueMigrationSucceeded;
+}
+
+#pragma mark Migration
+const ObjCDynamicCoderMigration * ObjCDynamicCoderGetMigration(
+    Class aClass,
+    const ObjCDynamicCoderClassPlan * plan,
+    NSInteger fromVersion,
+    NSInteger toVersion
+    )
+{
+    _Atomic(const ObjCDynamicCoderMigration *) * migrations
+    = &((ObjCDynamicCoderClassPlan *)plan) -> migrations;
+    
+    const ObjCDynamicCoderMigration * head
+    = atomic_load_explicit(migrations, memory_order_acquire);
+    
+    for (const ObjCDynamicCoderMigration * each = head; each != NULL; each = each -> next) {
+        if (each -> fromVersion == fromVersion && each -> toVersion == toVersion) {
+            return each;
+        }
+    }
+    
+    pthread_mutex_lock(&kObjCDynamicCoderMigrationLock);
+    
+    const ObjCDynamicCoderMigration * migration = NULL;
+    
+    // Migrations prepended since the lock-free lookup, including the ones
+    // compiled by a reentrant call on this thread.
+    for (const ObjCDynamicCoderMigration * each = atomic_load_explicit(migrations, memory_order_relaxed); each != head; each = each -> next) {
+        if (each -> fromVersion == fromVersion && each -> toVersion == toVersion) {
+            migration = each;
+            break;
+        }
+    }
+    
+    if (migration == NULL) {
+        ObjCDynamicCoderMigration * compiled
+        = ObjCDynamicCoderMigrationCreate(aClass, plan, fromVersion, toVersion);
+        
+        // Reloaded since compiling may have prepended reentrantly.
+        compiled -> next = atomic_load_explicit(migrations, memory_order_relaxed);
+        
+        atomic_store_explicit(migrations, compiled, memory_order_release);
+        
+        migration = compiled;
+    }
+    
+    pthread_mutex_unlock(&kObjCDynamicCoderMigrationLock);
+    
+    return migration;
+}
+
+ObjCDynamicCoderMigration * ObjCDynamicCoderMigrationCreate(
+    Class aClass,
+    const ObjCDynamicCoderClassPlan * plan,
+    NSInteger fromVersion,
+    NSInteger toVersion
+    )
+{
+    ObjCDynamicCoderMigration * migration = malloc(sizeof(ObjCDynamicCoderMigration));
+    
+    * migration = (ObjCDynamicCoderMigration){
+        fromVersion,
+        toVersion,
+        NULL,
+        NULL
+    };
+    
+    ObjCDynamicCoderMigrationPlan * migrationPlan
+    = [aClass migrationPlanFrom:fromVersion to:toVersion];
+    
+    if (migrationPlan == nil) {
+        return migration;
+    }
+    
+    migration -> properties
+    = calloc(plan -> propertyCount, sizeof(ObjCDynamicCoderPropertyMigration));
+    
+    for (NSUInteger index = 0; index < plan -> propertyCount; index ++) {
+        NSString * propertyName = plan -> properties[index].name;
+        
+        NSString * archivedKey = nil;
+        
+        if (![migrationPlan.droppedKeys containsObject:propertyName]) {
+            archivedKey = migrationPlan.renamedKeys[propertyName] ?: propertyName;
+        }
+        
+        ObjCDynamicCoderMigrationConversion conversion
+        = migrationPlan.conversions[propertyName];
+        
+        id defaultValue = migrationPlan.defaultValues[propertyName];
+        
+        migration -> properties[index] = (ObjCDynamicCoderPropertyMigration){
+            (__bridge NSString *)CFBridgingRetain(archivedKey),
+            (__bridge ObjCDynamicCoderMigrationConversion)CFBridgingRetain(conversion),
+            (__bridge id)CFBridgingRetain(defaultValue)
+        };
+    }
+    
+    return migration;
+}
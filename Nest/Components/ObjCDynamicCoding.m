@@ -189,6 +189,12 @@ id ObjCDynamicCodingDefaultDecodeCallBack (
 
         objc_property_t property = class_getProperty(aClass, [key UTF8String]);
 
+        // Values archived with keys other than property names (renamed by
+        // migrations, for example) are left as is.
+        if (property == NULL) {
+            return decodedValue;
+        }
+
         const char * propertyTypeEncoding
         = property_copyAttributeValue(property, "T");
 
@@ -8,7 +8,13 @@
 
 #import "ObjCDynamicObject.h"
 
-@interface ObjCDynamicObject()
+#import "ObjCDynamicObjectMappedArchive+Internal.h"
+
+@interface ObjCDynamicObject() {
+    /// Backs the values until the internal storage was loaded.
+    ObjCDynamicObjectMappedArchive * _mappedArchive;
+    NSUInteger _mappedIndex;
+}
 @property (nonatomic, readwrite, strong) NSMutableDictionary<NSString *, id> * internalStorage;
 
 static inline void ObjCDynamicObjectLoadInternalStorageIfNeeded(ObjCDynamicObject * self);
@@ -20,6 +26,11 @@ static inline void ObjCDynamicObjectLoadInternalStorageIfNeeded(ObjCDynamicObjec
     return _internalStorage;
 }
 
+- (void)setInternalStorage:(NSMutableDictionary<NSString *,id> *)internalStorage {
+    _internalStorage = internalStorage;
+    _mappedArchive = nil;
+}
+
 - (instancetype)init {
     self = [super init];
     return self;
@@ -31,6 +42,9 @@ static inline void ObjCDynamicObjectLoadInternalStorageIfNeeded(ObjCDynamicObjec
 }
 
 - (nullable id)primitiveValueForKey:(NSString *)key {
+    if (_internalStorage == nil && _mappedArchive != nil) {
+        return [_mappedArchive _valueForKey:key atIndex:_mappedIndex];
+    }
     ObjCDynamicObjectLoadInternalStorageIfNeeded(self);
     return _internalStorage[key];
 }
@@ -38,15 +52,36 @@ static inline void ObjCDynamicObjectLoadInternalStorageIfNeeded(ObjCDynamicObjec
 - (id)copyWithZone:(NSZone *)zone {
     ObjCDynamicObject * copied = [[[self class] allocWithZone:zone] init];
     copied -> _internalStorage = [_internalStorage mutableCopy];
+    copied -> _mappedArchive = _mappedArchive;
+    copied -> _mappedIndex = _mappedIndex;
     return copied;
 }
 
 static inline void ObjCDynamicObjectLoadInternalStorageIfNeeded(ObjCDynamicObject * self) {
     if (self -> _internalStorage == nil) {
-        self -> _internalStorage = [[NSMutableDictionary alloc] init];
+        if (self -> _mappedArchive != nil) {
+            // Copies the mapped values on the first write.
+            self -> _internalStorage = [self -> _mappedArchive _copyValuesAtIndex:self -> _mappedIndex];
+            self -> _mappedArchive = nil;
+        } else {
+            self -> _internalStorage = [[NSMutableDictionary alloc] init];
+        }
     }
 }
 @end
 
+@implementation ObjCDynamicObject (MappedArchive)
+- (instancetype)_initWithMappedArchive:(ObjCDynamicObjectMappedArchive *)archive
+                                 index:(NSUInteger)index
+{
+    self = [self init];
+    if (self) {
+        _mappedArchive = archive;
+        _mappedIndex = index;
+    }
+    return self;
+}
+@end
+
 
 
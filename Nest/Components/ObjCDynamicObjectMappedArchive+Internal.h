@@ -0,0 +1,27 @@
+//
+//  ObjCDynamicObjectMappedArchive+Internal.h
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+#import <Nest/ObjCDynamicObjectMappedArchive.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface ObjCDynamicObjectMappedArchive (Internal)
+/// Reads the value of `key` of the archived object at `index` from the
+/// mapped bytes.
+- (nullable id)_valueForKey:(NSString *)key atIndex:(NSUInteger)index;
+
+/// Copies all the values of the archived object at `index`.
+- (NSMutableDictionary<NSString *, id> *)_copyValuesAtIndex:(NSUInteger)index;
+@end
+
+@interface ObjCDynamicObject (MappedArchive)
+- (instancetype)_initWithMappedArchive:(ObjCDynamicObjectMappedArchive *)archive
+                                 index:(NSUInteger)index;
+@end
+
+NS_ASSUME_NONNULL_END
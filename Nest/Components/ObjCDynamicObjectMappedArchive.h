@@ -0,0 +1,73 @@
+//
+//  ObjCDynamicObjectMappedArchive.h
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+#import <Foundation/Foundation.h>
+#import <Nest/ObjCDynamicObject.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString * const ObjCDynamicObjectMappedArchiveErrorDomain;
+
+typedef NS_ENUM(NSInteger, ObjCDynamicObjectMappedArchiveError) {
+    /// An object is not an instance of the archived class.
+    ObjCDynamicObjectMappedArchiveErrorUnexpectedObject = 1,
+    /// A property holds a value which cannot be mapped. Only scalars,
+    /// structs without pointers, strings and selectors can be mapped.
+    ObjCDynamicObjectMappedArchiveErrorUnsupportedValue,
+    /// The archive is truncated or malformed.
+    ObjCDynamicObjectMappedArchiveErrorCorrupted,
+    /// The archived class is missing or its properties differ from the
+    /// archived ones.
+    ObjCDynamicObjectMappedArchiveErrorClassMismatch,
+};
+
+/** `ObjCDynamicObjectMappedArchive` is a read-only archive of
+ `ObjCDynamicObject` instances of one class, which is memory-mapped instead
+ of being decoded.
+ 
+ - Discussion: Objects vended by an archive serve scalars, structs, strings
+ and selectors straight from the mapped bytes, and copy their values into
+ the internal storage only on the first write. Thus opening an archive
+ costs the same no matter how many objects it contains, and only the pages
+ being read are resident.
+ */
+@interface ObjCDynamicObjectMappedArchive : NSObject
+/** Writes `objects` into a mapped archive at `url`.
+ 
+ @param     objects         The objects to write, which shall be instances
+ of `aClass`.
+ 
+ @param     aClass          The class of archived objects. An
+ `ObjCDynamicObject` subclass.
+ 
+ @param     url             A file URL.
+ 
+ @return    A flag indicates the writing succeeded or failed.
+ */
++ (BOOL)writeObjects:(NSArray<__kindof ObjCDynamicObject *> *)objects
+             ofClass:(Class)aClass
+               toURL:(NSURL *)url
+               error:(NSError * _Nullable * _Nullable)error;
+
+/// Maps the archive at `url`.
+- (nullable instancetype)initWithContentsOfURL:(NSURL *)url
+                                         error:(NSError * _Nullable * _Nullable)error NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@property (nonatomic, readonly, unsafe_unretained) Class objectClass;
+
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+/// Returns a new object backed by the archived object at `index`.
+- (__kindof ObjCDynamicObject *)objectAtIndex:(NSUInteger)index;
+
+- (__kindof ObjCDynamicObject *)objectAtIndexedSubscript:(NSUInteger)index;
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,761 @@
+//
+//  ObjCDynamicObjectMappedArchive.m
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+#import <Nest/ObjCDynamicObject+Subclass.h>
+
+#import "ObjCDynamicObjectMappedArchive+Internal.h"
+
+@import ObjectiveC;
+
+#pragma mark - Types
+/* Layout of an archive, all integers are in host byte order:
+ 
+ | Header | Columns | Rows | Strings |
+ 
+ Each row starts with a presence bitmap of its columns, followed by the
+ fields of its columns. Scalars and structs are stored raw, strings are
+ stored as `ObjCDynamicObjectMappedArchiveStringField`s pointing into the
+ strings region, which also contains the class name, the column names and
+ the type encodings.
+ */
+typedef NS_ENUM(uint32_t, ObjCDynamicObjectMappedArchiveColumnKind) {
+    ObjCDynamicObjectMappedArchiveColumnKindScalar,
+    ObjCDynamicObjectMappedArchiveColumnKindStruct,
+    /// Values are `NSString`s, stored as UTF-8.
+    ObjCDynamicObjectMappedArchiveColumnKindString,
+};
+
+typedef struct _ObjCDynamicObjectMappedArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+    uint32_t columnCount;
+    uint32_t rowStride;
+    uint64_t columnsOffset;
+    uint64_t rowsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsLength;
+    uint64_t classNameOffset;
+} ObjCDynamicObjectMappedArchiveHeader;
+
+typedef struct _ObjCDynamicObjectMappedArchiveColumnHeader {
+    uint64_t nameOffset;
+    uint64_t typeEncodingOffset;
+    uint32_t kind;
+    uint32_t fieldOffset;
+    uint32_t fieldSize;
+    uint32_t reserved;
+} ObjCDynamicObjectMappedArchiveColumnHeader;
+
+typedef struct _ObjCDynamicObjectMappedArchiveStringField {
+    uint64_t offset;
+    uint64_t length;
+} ObjCDynamicObjectMappedArchiveStringField;
+
+/// A column resolved when mapping an archive.
+typedef struct _ObjCDynamicObjectMappedArchiveColumn {
+    __unsafe_unretained NSString * name;
+    /// Points into the mapped bytes.
+    const char * typeEncoding;
+    ObjCDynamicObjectMappedArchiveColumnKind kind;
+    uint32_t fieldOffset;
+    uint32_t fieldSize;
+} ObjCDynamicObjectMappedArchiveColumn;
+
+@interface ObjCDynamicObjectMappedArchive() {
+    NSData * _data;
+    const uint8_t * _rows;
+    const uint8_t * _strings;
+    uint64_t _stringsLength;
+    uint32_t _rowStride;
+    NSUInteger _columnCount;
+    ObjCDynamicObjectMappedArchiveColumn * _columns;
+    /// Maps column names to column indices plus 1.
+    CFMutableDictionaryRef _columnIndices;
+    /// Keeps `_data` alive for strings created without copying bytes.
+    CFAllocatorRef _stringBytesDeallocator;
+}
+@end
+
+#pragma mark - Function Prototypes
+static NSArray<NSString *> * ObjCDynamicObjectMappedArchiveGetProperties(Class, NSArray<NSString *> * __autoreleasing *);
+
+static BOOL ObjCDynamicObjectMappedArchiveGetColumnKind(const char *, ObjCDynamicObjectMappedArchiveColumnKind *, NSUInteger *, NSUInteger *);
+
+static BOOL ObjCDynamicObjectMappedArchiveWriteRawValue(const char *, ObjCDynamicObjectMappedArchiveColumnKind, NSUInteger, id, void *);
+
+static id ObjCDynamicObjectMappedArchiveReadRawValue(const char *, ObjCDynamicObjectMappedArchiveColumnKind, const void *);
+
+static const char * ObjCDynamicObjectMappedArchiveGetCString(const uint8_t *, uint64_t, uint64_t);
+
+static NSError * ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveError, NSString *);
+
+static void * ObjCDynamicObjectMappedArchiveAllocateStringBytes(CFIndex, CFOptionFlags, void *);
+
+static void ObjCDynamicObjectMappedArchiveDeallocateStringBytes(void *, void *);
+
+#pragma mark - Variables
+NSString * const ObjCDynamicObjectMappedArchiveErrorDomain = @"com.WeZZard.Nest.ObjCDynamicObjectMappedArchive";
+
+/// "NSTM"
+static const uint32_t kObjCDynamicObjectMappedArchiveMagic = 0x4D54534E;
+
+static const uint32_t kObjCDynamicObjectMappedArchiveVersion = 1;
+
+static const uint64_t kObjCDynamicObjectMappedArchiveRowsAlignment = 16;
+
+@implementation ObjCDynamicObjectMappedArchive
++ (BOOL)writeObjects:(NSArray<__kindof ObjCDynamicObject *> *)objects
+             ofClass:(Class)aClass
+               toURL:(NSURL *)url
+               error:(NSError * _Nullable __autoreleasing *)error
+{
+    NSParameterAssert([aClass isSubclassOfClass:[ObjCDynamicObject class]]);
+    
+    for (ObjCDynamicObject * object in objects) {
+        if (![object isKindOfClass:aClass]) {
+            if (error) {
+                * error = ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveErrorUnexpectedObject, [NSString stringWithFormat:@"%@ is not an instance of %@.", object, NSStringFromClass(aClass)]);
+            }
+            return NO;
+        }
+    }
+    
+    NSArray<NSString *> * typeEncodingStrings = nil;
+    
+    NSArray<NSString *> * propertyNames = ObjCDynamicObjectMappedArchiveGetProperties(aClass, &typeEncodingStrings);
+    
+    NSUInteger propertyCount = propertyNames.count;
+    
+    const char ** typeEncodings = calloc(MAX(propertyCount, 1), sizeof(const char *));
+    
+    for (NSUInteger index = 0; index < propertyCount; index ++) {
+        typeEncodings[index] = [typeEncodingStrings[index] UTF8String];
+    }
+    
+    NSMutableData * strings = [[NSMutableData alloc] init];
+    NSMutableDictionary<NSString *, NSNumber *> * stringOffsets = [[NSMutableDictionary alloc] init];
+    
+    // Strings are uniqued, which makes reference tables with repeated
+    // values compact.
+    uint64_t (^appendString)(NSString *, uint64_t *) = ^(NSString * string, uint64_t * length) {
+        NSNumber * offset = stringOffsets[string];
+        
+        if (length) {
+            * length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        }
+        
+        if (offset != nil) {
+            return [offset unsignedLongLongValue];
+        }
+        
+        uint64_t newOffset = strings.length;
+        [strings appendData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+        [strings increaseLengthBy:1];
+        stringOffsets[string] = @(newOffset);
+        return newOffset;
+    };
+    
+    // Lay out columns. Properties which cannot be mapped are left out, and
+    // writing fails only when they hold a value.
+    NSUInteger columnCount = 0;
+    ObjCDynamicObjectMappedArchiveColumnHeader * columns
+    = calloc(MAX(propertyCount, 1), sizeof(ObjCDynamicObjectMappedArchiveColumnHeader));
+    NSUInteger * columnProperties = calloc(MAX(propertyCount, 1), sizeof(NSUInteger));
+    
+    NSUInteger maxAlignment = sizeof(uint64_t);
+    NSUInteger fieldOffset = (propertyCount + 7) / 8;
+    
+    BOOL succeeded = YES;
+    NSError * failure = nil;
+    
+    for (NSUInteger index = 0; index < propertyCount && succeeded; index ++) {
+        ObjCDynamicObjectMappedArchiveColumnKind kind;
+        NSUInteger size = 0, alignment = 1;
+        
+        if (!ObjCDynamicObjectMappedArchiveGetColumnKind(typeEncodings[index], &kind, &size, &alignment)) {
+            for (ObjCDynamicObject * object in objects) {
+                if ([object primitiveValueForKey:propertyNames[index]] != nil) {
+                    failure = ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveErrorUnsupportedValue, [NSString stringWithFormat:@"Property \"%@\" of type \"%s\" cannot be mapped.", propertyNames[index], typeEncodings[index]]);
+                    succeeded = NO;
+                    break;
+                }
+            }
+            continue;
+        }
+        
+        maxAlignment = MAX(maxAlignment, alignment);
+        fieldOffset = (fieldOffset + alignment - 1) / alignment * alignment;
+        
+        columns[columnCount] = (ObjCDynamicObjectMappedArchiveColumnHeader){
+            appendString(propertyNames[index], NULL),
+            appendString(@(typeEncodings[index]), NULL),
+            kind,
+            (uint32_t)fieldOffset,
+            (uint32_t)size,
+            0
+        };
+        columnProperties[columnCount] = index;
+        
+        fieldOffset += size;
+        columnCount += 1;
+    }
+    
+    uint32_t rowStride = (uint32_t)MAX((fieldOffset + maxAlignment - 1) / maxAlignment * maxAlignment, maxAlignment);
+    
+    NSMutableData * rows = nil;
+    
+    if (succeeded) {
+        rows = [[NSMutableData alloc] initWithLength:rowStride * objects.count];
+        uint8_t * row = rows.mutableBytes;
+        
+        for (ObjCDynamicObject * object in objects) {
+            for (NSUInteger column = 0; column < columnCount && succeeded; column ++) {
+                const ObjCDynamicObjectMappedArchiveColumnHeader * header = &columns[column];
+                NSUInteger property = columnProperties[column];
+                
+                id value = [object primitiveValueForKey:propertyNames[property]];
+                
+                if (value == nil) {
+                    continue;
+                }
+                
+                void * field = row + header -> fieldOffset;
+                
+                if (header -> kind == ObjCDynamicObjectMappedArchiveColumnKindString) {
+                    if ([value isKindOfClass:[NSString class]]) {
+                        ObjCDynamicObjectMappedArchiveStringField string;
+                        string.offset = appendString(value, &string.length);
+                        memcpy(field, &string, sizeof(string));
+                    } else {
+                        succeeded = NO;
+                    }
+                } else {
+                    succeeded = ObjCDynamicObjectMappedArchiveWriteRawValue(typeEncodings[property], header -> kind, header -> fieldSize, value, field);
+                }
+                
+                if (succeeded) {
+                    row[column / 8] |= (uint8_t)(1 << (column % 8));
+                } else {
+                    failure = ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveErrorUnsupportedValue, [NSString stringWithFormat:@"Value %@ of property \"%@\" cannot be mapped.", value, propertyNames[property]]);
+                }
+            }
+            
+            if (!succeeded) {
+                break;
+            }
+            
+            row += rowStride;
+        }
+    }
+    
+    NSMutableData * archive = nil;
+    
+    if (succeeded) {
+        ObjCDynamicObjectMappedArchiveHeader header = {0};
+        header.magic = kObjCDynamicObjectMappedArchiveMagic;
+        header.version = kObjCDynamicObjectMappedArchiveVersion;
+        header.count = objects.count;
+        header.columnCount = (uint32_t)columnCount;
+        header.rowStride = rowStride;
+        header.classNameOffset = appendString(NSStringFromClass(aClass), NULL);
+        header.columnsOffset = sizeof(ObjCDynamicObjectMappedArchiveHeader);
+        
+        uint64_t columnsEnd = header.columnsOffset + sizeof(ObjCDynamicObjectMappedArchiveColumnHeader) * columnCount;
+        
+        header.rowsOffset = (columnsEnd + kObjCDynamicObjectMappedArchiveRowsAlignment - 1) / kObjCDynamicObjectMappedArchiveRowsAlignment * kObjCDynamicObjectMappedArchiveRowsAlignment;
+        header.stringsOffset = header.rowsOffset + rows.length;
+        header.stringsLength = strings.length;
+        
+        archive = [[NSMutableData alloc] initWithCapacity:header.stringsOffset + header.stringsLength];
+        [archive appendBytes:&header length:sizeof(header)];
+        [archive appendBytes:columns length:sizeof(ObjCDynamicObjectMappedArchiveColumnHeader) * columnCount];
+        [archive setLength:header.rowsOffset];
+        [archive appendData:rows];
+        [archive appendData:strings];
+    }
+    
+    free(columns);
+    free(columnProperties);
+    free(typeEncodings);
+    
+    if (!succeeded) {
+        if (error) {
+            * error = failure;
+        }
+        return NO;
+    }
+    
+    return [archive writeToURL:url options:NSDataWritingAtomic error:error];
+}
+
+- (instancetype)init {
+    [self doesNotRecognizeSelector:_cmd];
+    return nil;
+}
+
+- (instancetype)initWithContentsOfURL:(NSURL *)url
+                                error:(NSError * _Nullable __autoreleasing *)error
+{
+    self = [super init];
+    if (self) {
+        _data = [NSData dataWithContentsOfURL:url
+                                      options:NSDataReadingMappedAlways
+                                        error:error];
+        
+        if (_data == nil) {
+            return nil;
+        }
+        
+        const uint8_t * bytes = _data.bytes;
+        uint64_t length = _data.length;
+        
+        ObjCDynamicObjectMappedArchiveHeader header;
+        
+        if (length < sizeof(header)) {
+            goto corrupted;
+        }
+        
+        memcpy(&header, bytes, sizeof(header));
+        
+        if (header.magic != kObjCDynamicObjectMappedArchiveMagic
+            || header.version != kObjCDynamicObjectMappedArchiveVersion)
+        {
+            goto corrupted;
+        }
+        
+        // Checks all the regions without overflowing.
+        if (header.stringsOffset > length
+            || header.stringsLength > length - header.stringsOffset
+            || header.columnsOffset > header.rowsOffset
+            || header.columnCount > (header.rowsOffset - header.columnsOffset) / sizeof(ObjCDynamicObjectMappedArchiveColumnHeader)
+            || header.rowsOffset % kObjCDynamicObjectMappedArchiveRowsAlignment != 0
+            || header.rowsOffset > header.stringsOffset
+            || header.rowStride == 0
+            || header.count > (header.stringsOffset - header.rowsOffset) / header.rowStride
+            || header.rowStride % sizeof(uint64_t) != 0
+            || header.rowStride < (header.columnCount + 7) / 8)
+        {
+            goto corrupted;
+        }
+        
+        _count = (NSUInteger)header.count;
+        _rowStride = header.rowStride;
+        _rows = bytes + header.rowsOffset;
+        _strings = bytes + header.stringsOffset;
+        _stringsLength = header.stringsLength;
+        
+        const char * className = ObjCDynamicObjectMappedArchiveGetCString(_strings, _stringsLength, header.classNameOffset);
+        
+        if (className == NULL) {
+            goto corrupted;
+        }
+        
+        _objectClass = objc_getClass(className);
+        
+        if (_objectClass == Nil || ![_objectClass isSubclassOfClass:[ObjCDynamicObject class]]) {
+            if (error) {
+                * error = ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveErrorClassMismatch, [NSString stringWithFormat:@"Archived class %s is not an ObjCDynamicObject subclass.", className]);
+            }
+            return nil;
+        }
+        
+        _columnCount = header.columnCount;
+        _columns = calloc(MAX(_columnCount, 1), sizeof(ObjCDynamicObjectMappedArchiveColumn));
+        _columnIndices = CFDictionaryCreateMutable(kCFAllocatorDefault, _columnCount, &kCFTypeDictionaryKeyCallBacks, NULL);
+        
+        for (NSUInteger index = 0; index < _columnCount; index ++) {
+            ObjCDynamicObjectMappedArchiveColumnHeader columnHeader;
+            memcpy(&columnHeader, bytes + header.columnsOffset + index * sizeof(columnHeader), sizeof(columnHeader));
+            
+            const char * name = ObjCDynamicObjectMappedArchiveGetCString(_strings, _stringsLength, columnHeader.nameOffset);
+            const char * typeEncoding = ObjCDynamicObjectMappedArchiveGetCString(_strings, _stringsLength, columnHeader.typeEncodingOffset);
+            
+            ObjCDynamicObjectMappedArchiveColumnKind kind;
+            NSUInteger size = 0, alignment = 1;
+            
+            if (name == NULL
+                || typeEncoding == NULL
+                || !ObjCDynamicObjectMappedArchiveGetColumnKind(typeEncoding, &kind, &size, &alignment)
+                || kind != columnHeader.kind
+                || size != columnHeader.fieldSize
+                || columnHeader.fieldOffset % alignment != 0
+                || columnHeader.fieldOffset < (_columnCount + 7) / 8
+                || (uint64_t)columnHeader.fieldOffset + columnHeader.fieldSize > _rowStride)
+            {
+                goto corrupted;
+            }
+            
+            objc_property_t property = class_getProperty(_objectClass, name);
+            char * propertyTypeEncoding = property ? property_copyAttributeValue(property, "T") : NULL;
+            BOOL matched = propertyTypeEncoding != NULL && strcmp(propertyTypeEncoding, typeEncoding) == 0;
+            free(propertyTypeEncoding);
+            
+            if (!matched) {
+                if (error) {
+                    * error = ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveErrorClassMismatch, [NSString stringWithFormat:@"Archived property \"%s\" of type \"%s\" does not match class %s.", name, typeEncoding, className]);
+                }
+                return nil;
+            }
+            
+            NSString * columnName = @(name);
+            
+            _columns[index] = (ObjCDynamicObjectMappedArchiveColumn){
+                (__bridge NSString *)CFBridgingRetain(columnName),
+                typeEncoding,
+                kind,
+                columnHeader.fieldOffset,
+                columnHeader.fieldSize
+            };
+            
+            CFDictionarySetValue(_columnIndices, (__bridge CFStringRef)columnName, (const void *)(uintptr_t)(index + 1));
+        }
+        
+        CFAllocatorContext context = {
+            0,
+            (__bridge void *)_data,
+            CFRetain,
+            CFRelease,
+            NULL,
+            ObjCDynamicObjectMappedArchiveAllocateStringBytes,
+            NULL,
+            ObjCDynamicObjectMappedArchiveDeallocateStringBytes,
+            NULL
+        };
+        
+        _stringBytesDeallocator = CFAllocatorCreate(kCFAllocatorDefault, &context);
+    }
+    return self;
+
+corrupted:
+    if (error) {
+        * error = ObjCDynamicObjectMappedArchiveErrorMake(ObjCDynamicObjectMappedArchiveErrorCorrupted, [NSString stringWithFormat:@"%@ is not a valid mapped archive.", url]);
+    }
+    return nil;
+}
+
+- (void)dealloc {
+    for (NSUInteger index = 0; index < _columnCount; index ++) {
+        if (_columns[index].name != nil) {
+            CFRelease((__bridge CFStringRef)_columns[index].name);
+        }
+    }
+    free(_columns);
+    
+    if (_columnIndices != NULL) {
+        CFRelease(_columnIndices);
+    }
+    
+    if (_stringBytesDeallocator != NULL) {
+        CFRelease(_stringBytesDeallocator);
+    }
+}
+
+- (__kindof ObjCDynamicObject *)objectAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"Index %lu beyond bounds [0 .. %lu).", (unsigned long)index, (unsigned long)_count];
+    }
+    
+    return [[_objectClass alloc] _initWithMappedArchive:self index:index];
+}
+
+- (__kindof ObjCDynamicObject *)objectAtIndexedSubscript:(NSUInteger)index {
+    return [self objectAtIndex:index];
+}
+
+#pragma mark Internal
+- (id)_valueForKey:(NSString *)key atIndex:(NSUInteger)index {
+    uintptr_t columnIndex = (uintptr_t)CFDictionaryGetValue(_columnIndices, (__bridge CFStringRef)key);
+    
+    if (columnIndex == 0) {
+        return nil;
+    }
+    
+    return [self _valueOfColumn:columnIndex - 1 atIndex:index];
+}
+
+- (NSMutableDictionary<NSString *, id> *)_copyValuesAtIndex:(NSUInteger)index {
+    NSMutableDictionary<NSString *, id> * values
+    = [[NSMutableDictionary alloc] initWithCapacity:_columnCount];
+    
+    for (NSUInteger column = 0; column < _columnCount; column ++) {
+        id value = [self _valueOfColumn:column atIndex:index];
+        
+        if (value != nil) {
+            values[_columns[column].name] = value;
+        }
+    }
+    
+    return values;
+}
+
+- (id)_valueOfColumn:(NSUInteger)columnIndex atIndex:(NSUInteger)index {
+    const uint8_t * row = _rows + (uint64_t)index * _rowStride;
+    
+    if ((row[columnIndex / 8] & (1 << (columnIndex % 8))) == 0) {
+        return nil;
+    }
+    
+    const ObjCDynamicObjectMappedArchiveColumn * column = &_columns[columnIndex];
+    const uint8_t * field = row + column -> fieldOffset;
+    
+    if (column -> kind != ObjCDynamicObjectMappedArchiveColumnKindString) {
+        return ObjCDynamicObjectMappedArchiveReadRawValue(column -> typeEncoding, column -> kind, field);
+    }
+    
+    ObjCDynamicObjectMappedArchiveStringField string;
+    memcpy(&string, field, sizeof(string));
+    
+    if (string.offset > _stringsLength
+        || string.length > _stringsLength - string.offset
+        || string.length > LONG_MAX)
+    {
+        return nil;
+    }
+    
+    // The string references the mapped bytes, and keeps them alive through
+    // its contents deallocator.
+    return (__bridge_transfer NSString *)CFStringCreateWithBytesNoCopy(
+        kCFAllocatorDefault,
+        _strings + string.offset,
+        (CFIndex)string.length,
+        kCFStringEncodingUTF8,
+        false,
+        _stringBytesDeallocator
+    );
+}
+@end
+
+#pragma mark - Functions
+NSArray<NSString *> * ObjCDynamicObjectMappedArchiveGetProperties(
+    Class aClass,
+    NSArray<NSString *> * __autoreleasing * typeEncodings
+    )
+{
+    NSMutableArray<NSString *> * propertyNames = [[NSMutableArray alloc] init];
+    NSMutableArray<NSString *> * propertyTypeEncodings = [[NSMutableArray alloc] init];
+    
+    NSMutableSet<NSString *> * visitedPropertyNames = [[NSMutableSet alloc] init];
+    
+    Class inspectedClass = aClass;
+    
+    Class searchingTerminateClass = [ObjCDynamicObject class];
+    
+    while (inspectedClass != searchingTerminateClass && inspectedClass != Nil) {
+        unsigned int propertyCount = 0;
+        
+        objc_property_t * propertyList
+        = class_copyPropertyList(inspectedClass, &propertyCount);
+        
+        for (unsigned int index = 0; index < propertyCount; index ++) {
+            objc_property_t property = propertyList[index];
+            
+            char * isDynamic = property_copyAttributeValue(property, "D");
+            
+            if (isDynamic == NULL) {
+                continue;
+            }
+            
+            free(isDynamic);
+            
+            NSString * propertyName
+            = [NSString stringWithCString:property_getName(property)
+                                 encoding:NSUTF8StringEncoding];
+            
+            // Properties redeclared in subclasses are inspected only once.
+            if ([visitedPropertyNames containsObject:propertyName]) {
+                continue;
+            }
+            
+            [visitedPropertyNames addObject:propertyName];
+            
+            char * typeEncoding = property_copyAttributeValue(property, "T");
+            
+            [propertyNames addObject:propertyName];
+            [propertyTypeEncodings addObject:@(typeEncoding)];
+            
+            free(typeEncoding);
+        }
+        
+        free(propertyList);
+        
+        inspectedClass = [inspectedClass superclass];
+    }
+    
+    * typeEncodings = propertyTypeEncodings;
+    
+    return propertyNames;
+}
+
+BOOL ObjCDynamicObjectMappedArchiveGetColumnKind(
+    const char * typeEncoding,
+    ObjCDynamicObjectMappedArchiveColumnKind * kind,
+    NSUInteger * size,
+    NSUInteger * alignment
+    )
+{
+    switch (* typeEncoding) {
+        case 'c': case 'i': case 's': case 'l': case 'q':
+        case 'C': case 'I': case 'S': case 'L': case 'Q':
+        case 'B': case 'f': case 'd':
+            NSGetSizeAndAlignment(typeEncoding, size, alignment);
+            * kind = ObjCDynamicObjectMappedArchiveColumnKindScalar;
+            return YES;
+        case '{':
+            // Structs with pointers, objects or unions cannot be mapped.
+            if (strpbrk(typeEncoding, "@^*:#?(") != NULL) {
+                return NO;
+            }
+            NSGetSizeAndAlignment(typeEncoding, size, alignment);
+            * alignment = MIN(* alignment, sizeof(uint64_t));
+            * kind = ObjCDynamicObjectMappedArchiveColumnKindStruct;
+            return YES;
+        case '@':
+            // Only strings are mapped. Other object properties are left out.
+            if (strcmp(typeEncoding, "@\"NSString\"") != 0) {
+                return NO;
+            }
+            * size = sizeof(ObjCDynamicObjectMappedArchiveStringField);
+            * alignment = sizeof(uint64_t);
+            * kind = ObjCDynamicObjectMappedArchiveColumnKindString;
+            return YES;
+        case ':':
+            // Selectors are stored as strings by the dynamic accessors.
+            * size = sizeof(ObjCDynamicObjectMappedArchiveStringField);
+            * alignment = sizeof(uint64_t);
+            * kind = ObjCDynamicObjectMappedArchiveColumnKindString;
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+BOOL ObjCDynamicObjectMappedArchiveWriteRawValue(
+    const char * typeEncoding,
+    ObjCDynamicObjectMappedArchiveColumnKind kind,
+    NSUInteger size,
+    id value,
+    void * field
+    )
+{
+    if (kind == ObjCDynamicObjectMappedArchiveColumnKindStruct) {
+        if (![value isKindOfClass:[NSValue class]]) {
+            return NO;
+        }
+        
+        NSUInteger valueSize = 0;
+        NSGetSizeAndAlignment([value objCType], &valueSize, NULL);
+        
+        if (valueSize != size) {
+            return NO;
+        }
+        
+        [value getValue:field];
+        return YES;
+    }
+    
+    if (![value isKindOfClass:[NSNumber class]]) {
+        return NO;
+    }
+    
+    NSNumber * number = value;
+    
+    // "l" and "L" are 32-bit quantities in type encodings.
+    switch (typeEncoding[0]) {
+        case 'c': * (char *)field = [number charValue];                             break;
+        case 'i': * (int *)field = [number intValue];                               break;
+        case 's': * (short *)field = [number shortValue];                           break;
+        case 'l': * (int32_t *)field = [number intValue];                           break;
+        case 'q': * (long long *)field = [number longLongValue];                    break;
+        case 'C': * (unsigned char *)field = [number unsignedCharValue];            break;
+        case 'I': * (unsigned int *)field = [number unsignedIntValue];              break;
+        case 'S': * (unsigned short *)field = [number unsignedShortValue];          break;
+        case 'L': * (uint32_t *)field = [number unsignedIntValue];                  break;
+        case 'Q': * (unsigned long long *)field = [number unsignedLongLongValue];   break;
+        case 'B': * (bool *)field = [number boolValue];                             break;
+        case 'f': * (float *)field = [number floatValue];                           break;
+        case 'd': * (double *)field = [number doubleValue];                         break;
+        default: return NO;
+    }
+    
+    return YES;
+}
+
+id ObjCDynamicObjectMappedArchiveReadRawValue(
+    const char * typeEncoding,
+    ObjCDynamicObjectMappedArchiveColumnKind kind,
+    const void * field
+    )
+{
+    if (kind == ObjCDynamicObjectMappedArchiveColumnKindStruct) {
+        return [NSValue valueWithBytes:field objCType:typeEncoding];
+    }
+    
+    switch (typeEncoding[0]) {
+        case 'c': return @(* (const char *)field);
+        case 'i': return @(* (const int *)field);
+        case 's': return @(* (const short *)field);
+        case 'l': return @(* (const int32_t *)field);
+        case 'q': return @(* (const long long *)field);
+        case 'C': return @(* (const unsigned char *)field);
+        case 'I': return @(* (const unsigned int *)field);
+        case 'S': return @(* (const unsigned short *)field);
+        case 'L': return @(* (const uint32_t *)field);
+        case 'Q': return @(* (const unsigned long long *)field);
+        case 'B': return @(* (const bool *)field);
+        case 'f': return @(* (const float *)field);
+        case 'd': return @(* (const double *)field);
+        default: return nil;
+    }
+}
+
+const char * ObjCDynamicObjectMappedArchiveGetCString(
+    const uint8_t * strings,
+    uint64_t length,
+    uint64_t offset
+    )
+{
+    if (offset >= length) {
+        return NULL;
+    }
+    
+    // The string shall be terminated inside the strings region.
+    if (memchr(strings + offset, '\0', (size_t)(length - offset)) == NULL) {
+        return NULL;
+    }
+    
+    return (const char *)(strings + offset);
+}
+
+NSError * ObjCDynamicObjectMappedArchiveErrorMake(
+    ObjCDynamicObjectMappedArchiveError code,
+    NSString * description
+    )
+{
+    return [NSError errorWithDomain:ObjCDynamicObjectMappedArchiveErrorDomain
+                               code:code
+                           userInfo:@{NSLocalizedDescriptionKey: description}];
+}
+
+void * ObjCDynamicObjectMappedArchiveAllocateStringBytes(
+    CFIndex size,
+    CFOptionFlags hint,
+    void * info
+    )
+{
+    return NULL;
+}
+
+void ObjCDynamicObjectMappedArchiveDeallocateStringBytes(
+    void * pointer,
+    void * info
+    )
+{
+    // The bytes belong to the mapped file, which is unmapped when the
+    // allocator releases it.
+}
@@ -9,6 +9,7 @@
 import Foundation
 import ObjectiveC
 import SwiftExt
+import Nest.AtomicUtilities
 
 extension NSObject {
     @objc(nest_graftProtocolImplementationOfProtocol:onGraftingClass:)
@@ -67,43 +68,20 @@ public func ObjCGraftProtocolImplementation(
 {
     let GraftedObject: AnyClass = type(of: graftedObject)
     
-    for (unownedProtocol, GraftingClass) in graftingTable._content {
-        let `protocol` = unownedProtocol.value
-        // class_conformsToProtocol only checks on current class.
-        precondition(class_conformsToProtocol(GraftedObject, `protocol`))
-        // [NSObject +conformsToProtocol:] checks the whole class hierarchy.
-        precondition(GraftingClass.conforms(to: `protocol`))
-    }
-    
-    let graftBundle = _ObjCProtocolImplementationGraftedClass(
+    if let GraftedClass = _ObjCProtocolImplementationGraftedClass(
         for: GraftedObject, with: graftingTable
-    )
-    
-    let GraftedClass: AnyClass = graftBundle.graftedClass
-    let finalGraftingTable = graftBundle.graftingTable
-    
-    if (GraftedObject.self != GraftedClass.self) {
+        )
+    {
         object_setClass(graftedObject, GraftedClass)
-        
-        for (unownedProtocol, GraftingClass) in finalGraftingTable._content {
-            let `protocol` = unownedProtocol.value
-            _ObjCGraftImplementation(
-                of: `protocol`, on: GraftingClass, to: graftedObject
-            )
-        }
-        
-    } else {
-        assert(finalGraftingTable._content.isEmpty)
     }
 }
 
 private func _ObjCGraftImplementation(
     of aProtocol: Protocol,
     on GraftingClass: AnyClass,
-    to graftedObject: AnyObject
+    to GraftedClass: AnyClass
     )
 {
-    let GraftedClass: AnyClass = type(of: graftedObject)
     let MetaGraftedClass: AnyClass = objc_getMetaClass(
         NSStringFromClass(GraftedClass)
         ) as! AnyClass
@@ -274,16 +252,35 @@ public struct ObjCProtocolImplementationGraftingTable:
     
     fileprivate let _content: [Unowned<Protocol>: AnyClass]
     
+    /// Object identifiers of `_content`, computed once for looking up
+    /// grafted classes.
+    fileprivate let _identifiers: [ObjectIdentifier: ObjectIdentifier]
+    
+    fileprivate let _identifiersHashValue: Int
+    
     public init(dictionaryLiteral elements: (Key, Value)...) {
         var content = [(Unowned<Protocol>) : AnyClass]()
         for (key, value) in elements {
             content[Unowned(key)] = value
         }
-        _content = content
+        self.init(graftingPairs: content)
     }
     
     fileprivate init(graftingPairs: [Unowned<Protocol>: AnyClass]) {
         _content = graftingPairs
+        
+        var identifiers = [ObjectIdentifier: ObjectIdentifier]()
+        var hashValue = 0
+        for (key, value) in graftingPairs {
+            let protocolIdentifier = ObjectIdentifier(key.value)
+            let classIdentifier = ObjectIdentifier(value)
+            identifiers[protocolIdentifier] = classIdentifier
+            // Order insensitive since dictionaries are unordered.
+            hashValue ^= protocolIdentifier.hashValue &* 31
+                &+ classIdentifier.hashValue
+        }
+        _identifiers = identifiers
+        _identifiersHashValue = hashValue
     }
     
     fileprivate var _graftingPairStrings: [String] {
@@ -297,44 +294,98 @@ public struct ObjCProtocolImplementationGraftingTable:
     }
 }
 
+/// Returns the grafted class with the implementations of `graftingTable`
+/// installed for an object of `class`, or `nil` when the object's class has
+/// already been grafted with `graftingTable`.
+///
+/// - Notes: Results are looked up in `_graftedClassCache` without locking,
+/// only a miss synchronizes with `_graftedClassRegistryQueue`.
 private func _ObjCProtocolImplementationGraftedClass(
     for class: AnyClass,
     with graftingTable: ObjCProtocolImplementationGraftingTable
-    ) -> (
-    graftedClass: AnyClass,
-    graftingTable: ObjCProtocolImplementationGraftingTable
+    ) -> AnyClass?
+{
+    let cacheKey = _ObjCProtocolImplementationGraftedClassKey(
+        baseClass: `class`, graftingTable: graftingTable
     )
+    
+    if let cachedGraftedClass
+        = _graftedClassCache.graftedClass(for: cacheKey)
+    {
+        return cachedGraftedClass
+    }
+    
+    return _graftedClassRegistryQueue.sync { () -> AnyClass? in
+        if let cachedGraftedClass
+            = _graftedClassCache.graftedClass(for: cacheKey)
+        {
+            return cachedGraftedClass
+        }
+        
+        let GraftedClass = _ObjCResolveProtocolImplementationGraftedClass(
+            for: `class`, with: graftingTable
+        )
+        
+        _graftedClassCache.insert(GraftedClass, for: cacheKey)
+        
+        return GraftedClass
+    }
+}
+
+/// Called on `_graftedClassRegistryQueue`.
+private func _ObjCResolveProtocolImplementationGraftedClass(
+    for class: AnyClass,
+    with graftingTable: ObjCProtocolImplementationGraftingTable
+    ) -> AnyClass?
 {
+    let BaseClass: AnyClass
+    let baseGraftingTable: ObjCProtocolImplementationGraftingTable
     
-    if let graftedClass = `class` as? _ObjCProtocolImplementationGrafted.Type {
-        let existedGraftingPairs = graftedClass._graftingPairs
+    if let record = _graftedClassRecords[ObjectIdentifier(`class`)] {
         let wantedGraftingPairs = graftingTable._content
-        if existedGraftingPairs.contains(
-            wantedGraftingPairs, 
+        if record.graftingPairs.contains(
+            wantedGraftingPairs,
             predicate: {$0.0 == $1.0 && $0.1 == $1.1}
             )
         {
-            return (`class`, [:])
-        } else {
-            var newGraftingPairs = existedGraftingPairs
-            for (key, value) in wantedGraftingPairs {
-                newGraftingPairs[key] = value
-            }
-            let newGraftingTable = ObjCProtocolImplementationGraftingTable(
-                graftingPairs: newGraftingPairs
-            )
-            return (_ObjCCreateProtocolImplementationGraftedClass(
-                for: class_getSuperclass(`class`),
-                with: newGraftingTable
-            ), newGraftingTable)
+            return nil
+        }
+        BaseClass = record.baseClass
+        var graftingPairs = record.graftingPairs
+        for (key, value) in wantedGraftingPairs {
+            graftingPairs[key] = value
         }
+        baseGraftingTable = ObjCProtocolImplementationGraftingTable(
+            graftingPairs: graftingPairs
+        )
     } else {
-        return (_ObjCCreateProtocolImplementationGraftedClass(
-            for: `class`, with: graftingTable
-        ), graftingTable)
+        BaseClass = `class`
+        baseGraftingTable = graftingTable
+    }
+    
+    let key = _ObjCProtocolImplementationGraftedClassKey(
+        baseClass: BaseClass, graftingTable: baseGraftingTable
+    )
+    
+    if let GraftedClass = _graftedClasses[key] {
+        return GraftedClass
     }
+    
+    let GraftedClass: AnyClass = _ObjCCreateProtocolImplementationGraftedClass(
+        for: BaseClass, with: baseGraftingTable
+    )
+    
+    _graftedClasses[key] = GraftedClass
+    _graftedClassRecords[ObjectIdentifier(GraftedClass)]
+        = _ObjCProtocolImplementationGraftedClassRecord(
+            baseClass: BaseClass, graftingPairs: baseGraftingTable._content
+    )
+    
+    return GraftedClass
 }
 
+/// Creates a grafted class and installs the implementations of
+/// `graftingTable` on it.
 private func _ObjCCreateProtocolImplementationGraftedClass(
     for class: AnyClass,
     with graftingTable: ObjCProtocolImplementationGraftingTable
@@ -342,6 +393,14 @@ private func _ObjCCreateProtocolImplementationGraftedClass(
 {
     precondition(!(`class` is _ObjCProtocolImplementationGrafted))
     
+    for (unownedProtocol, GraftingClass) in graftingTable._content {
+        let `protocol` = unownedProtocol.value
+        // class_conformsToProtocol only checks on current class.
+        precondition(class_conformsToProtocol(`class`, `protocol`))
+        // [NSObject +conformsToProtocol:] checks the whole class hierarchy.
+        precondition(GraftingClass.conforms(to: `protocol`))
+    }
+    
     let className = "ObjCProtocolImplementationGrafted_"
         + NSStringFromClass(`class`)
         + "|"
@@ -352,6 +411,12 @@ private func _ObjCCreateProtocolImplementationGraftedClass(
     
     objc_registerClassPair(Subclass)
     
+    for (unownedProtocol, GraftingClass) in graftingTable._content {
+        _ObjCGraftImplementation(
+            of: unownedProtocol.value, on: GraftingClass, to: Subclass
+        )
+    }
+    
     return Subclass
 }
 
@@ -360,27 +425,123 @@ private protocol _ObjCProtocolImplementationGrafted: class {
     
 }
 
-extension _ObjCProtocolImplementationGrafted {
-    fileprivate static var _graftingPairs: [Unowned<Protocol>: AnyClass] {
-        let className = NSStringFromClass(self)
-        let components = className.components(separatedBy: "|")
-        assert((components.count & 0b1) == 0 && components.count > 1)
-        let validComponents = components.dropFirst().map {
-            (component) -> (Unowned<Protocol>, AnyClass) in
-            let paired = component.components(separatedBy: "->")
-            assert(paired.count == 2)
-            let `protocol` = NSProtocolFromString(paired[0])!
-            let `class`: AnyClass = NSClassFromString(paired[1])!
-            return (Unowned(`protocol`), `class`)
+private struct _ObjCProtocolImplementationGraftedClassKey: Hashable {
+    let baseClass: ObjectIdentifier
+    let graftingPairs: [ObjectIdentifier: ObjectIdentifier]
+    let hashValue: Int
+    
+    /// Takes the identifiers precomputed by `graftingTable`.
+    init(
+        baseClass: AnyClass,
+        graftingTable: ObjCProtocolImplementationGraftingTable
+        )
+    {
+        self.baseClass = ObjectIdentifier(baseClass)
+        graftingPairs = graftingTable._identifiers
+        hashValue = self.baseClass.hashValue
+            ^ graftingTable._identifiersHashValue
+    }
+    
+    static func == (
+        lhs: _ObjCProtocolImplementationGraftedClassKey,
+        rhs: _ObjCProtocolImplementationGraftedClassKey
+        ) -> Bool
+    {
+        return lhs.baseClass == rhs.baseClass
+            && lhs.graftingPairs == rhs.graftingPairs
+    }
+}
+
+private struct _ObjCProtocolImplementationGraftedClassRecord {
+    let baseClass: AnyClass
+    let graftingPairs: [Unowned<Protocol>: AnyClass]
+}
+
+/// Grafted classes keyed by their base class and grafting pairs.
+private var _graftedClasses
+    = [_ObjCProtocolImplementationGraftedClassKey: AnyClass]()
+
+/// Base class and grafting pairs of each grafted class.
+private var _graftedClassRecords
+    = [ObjectIdentifier: _ObjCProtocolImplementationGraftedClassRecord]()
+
+/// Results of `_ObjCProtocolImplementationGraftedClass` keyed by the class
+/// of the grafted object and the grafting table, which are read without
+/// locking.
+///
+/// - Notes: Readers atomically load the current snapshot, an immutable
+/// dictionary. Writers publish a new snapshot under
+/// `_graftedClassRegistryQueue`. Replaced snapshots are kept, so a reader
+/// never sees a released one. There is one snapshot for each pair of
+/// class and grafting table ever grafted.
+private final class _ObjCProtocolImplementationGraftedClassCache {
+    private final class _Snapshot {
+        let graftedClasses:
+            [_ObjCProtocolImplementationGraftedClassKey: AnyClass?]
+        
+        init(
+            graftedClasses:
+            [_ObjCProtocolImplementationGraftedClassKey: AnyClass?]
+            )
+        {
+            self.graftedClasses = graftedClasses
         }
-        var dictionary = [(Unowned<Protocol>) : AnyClass]()
-        for (key, value) in validComponents {
-            dictionary[key] = value
+    }
+    
+    /// An unmanaged `_Snapshot`, accessed atomically.
+    private let _current: UnsafeMutablePointer<UnsafeMutableRawPointer?>
+    
+    /// Only accessed on `_graftedClassRegistryQueue`.
+    private var _snapshots: [_Snapshot] = []
+    
+    init() {
+        _current = UnsafeMutablePointer.allocate(capacity: 1)
+        _current.initialize(to: nil)
+    }
+    
+    deinit {
+        _current.deinitialize()
+        _current.deallocate(capacity: 1)
+    }
+    
+    /// Called from any thread. Returns `.some(nil)` when the class has
+    /// already been grafted with the table.
+    func graftedClass(
+        for key: _ObjCProtocolImplementationGraftedClassKey
+        ) -> AnyClass??
+    {
+        guard let current = _NestAtomicLoadPointer(_current) else {
+            return nil
         }
-        return dictionary
+        return Unmanaged<_Snapshot>.fromOpaque(current)
+            .takeUnretainedValue().graftedClasses[key]
+    }
+    
+    /// Called on `_graftedClassRegistryQueue`.
+    func insert(
+        _ graftedClass: AnyClass?,
+        for key: _ObjCProtocolImplementationGraftedClassKey
+        )
+    {
+        var graftedClasses = _snapshots.last?.graftedClasses ?? [:]
+        graftedClasses.updateValue(graftedClass, forKey: key)
+        
+        let snapshot = _Snapshot(graftedClasses: graftedClasses)
+        _snapshots.append(snapshot)
+        
+        _NestAtomicStorePointer(
+            _current, Unmanaged.passUnretained(snapshot).toOpaque()
+        )
     }
 }
 
+private let _graftedClassCache
+    = _ObjCProtocolImplementationGraftedClassCache()
+
+private let _graftedClassRegistryQueue = DispatchQueue(
+    label: "com.WeZZard.Nest.ObjCGraftProtocolImplementation.Registry"
+)
+
 //MARK: - Ungraft
 @discardableResult
 public func ObjCUngraftProtocolImplementationsAll<Grafted: AnyObject>(
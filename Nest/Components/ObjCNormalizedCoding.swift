@@ -393,3 +393,345 @@ extension RawRepresentable where Self: _ObjectiveCBridgeable,
         }
     }
 }
+
+//MARK: - Bulk Coding
+/// Types whose values are laid out in a fixed number of bytes without any
+/// reference, which can be coded in bulk as one contiguous byte buffer.
+///
+/// Bulk coded buffers are prefixed with a header of 16 bytes: a magic
+/// number (`UInt32`), the element size (`UInt16`), the flags (`UInt16`)
+/// and the element count (`UInt64`). Both the header and the elements are
+/// stored in little endian.
+public protocol ObjCNormalizedBulkCoding: ObjCNormalizedCoding {
+    /// Creates a value of all zero bits.
+    init()
+    
+    /// The little-endian representation of the value.
+    var littleEndian: Self { get }
+    
+    /// Creates a value from its little-endian representation.
+    init(littleEndian value: Self)
+}
+
+/// Bulk coding types made of platform-width scalars (`Int`, `UInt` and
+/// `CGFloat`), whose element size differs between 32-bit and 64-bit
+/// platforms. Buffers of them are flagged so that they can be decoded on a
+/// platform of the other width.
+internal protocol _ObjCNormalizedPlatformWidthBulkCoding {
+    /// The number of platform-width scalars a value is made of.
+    static var _platformWidthScalarCount: Int { get }
+    
+    /// Converts a little-endian scalar of `size` bytes at `source` to a
+    /// native scalar at `destination`. Throws when the scalar doesn't fit.
+    static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+}
+
+extension Int: ObjCNormalizedBulkCoding {}
+
+extension Int: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 1 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        let value: Int64
+        switch size {
+        case 4: value = Int64(Int32(littleEndian: _loadUnaligned(source)))
+        case 8: value = Int64(littleEndian: _loadUnaligned(source))
+        default: throw _platformWidthScalarSizeError(size, for: key)
+        }
+        guard value >= Int64(Int.min) && value <= Int64(Int.max) else {
+            throw _platformWidthScalarOverflowError(value, for: key)
+        }
+        destination.storeBytes(of: Int(value), as: Int.self)
+    }
+}
+
+extension Int8: ObjCNormalizedBulkCoding {}
+
+extension Int16: ObjCNormalizedBulkCoding {}
+
+extension Int32: ObjCNormalizedBulkCoding {}
+
+extension Int64: ObjCNormalizedBulkCoding {}
+
+extension UInt: ObjCNormalizedBulkCoding {}
+
+extension UInt: _ObjCNormalizedPlatformWidthBulkCoding {
+    internal static var _platformWidthScalarCount: Int { return 1 }
+    
+    internal static func _convertPlatformWidthScalar(
+        from source: UnsafeRawPointer, size: Int,
+        to destination: UnsafeMutableRawPointer, for key: String
+        ) throws
+    {
+        let value: UInt64
+        switch size {
+        case 4: value = UInt64(UInt32(littleEndian: _loadUnaligned(source)))
+        case 8: value = UInt64(littleEndian: _loadUnaligned(source))
+        default: throw _platformWidthScalarSizeError(size, for: key)
+        }
+        guard value <= UInt64(UInt.max) else {
+            throw _platformWidthScalarOverflowError(value, for: key)
+        }
+        destination.storeBytes(of: UInt(value), as: UInt.self)
+    }
+}
+
+extension UInt8: ObjCNormalizedBulkCoding {}
+
+extension UInt16: ObjCNormalizedBulkCoding {}
+
+extension UInt32: ObjCNormalizedBulkCoding {}
+
+extension UInt64: ObjCNormalizedBulkCoding {}
+
+extension Float: ObjCNormalizedBulkCoding {
+    public var littleEndian: Float {
+        return Float(bitPattern: bitPattern.littleEndian)
+    }
+    
+    public init(littleEndian value: Float) {
+        self.init(bitPattern: UInt32(littleEndian: value.bitPattern))
+    }
+}
+
+extension Double: ObjCNormalizedBulkCoding {
+    public var littleEndian: Double {
+        return Double(bitPattern: bitPattern.littleEndian)
+    }
+    
+    public init(littleEndian value: Double) {
+        self.init(bitPattern: UInt64(littleEndian: value.bitPattern))
+    }
+}
+
+/// Loads a value of type `T` from `source` regardless of its alignment.
+internal func _loadUnaligned<T: ObjCNormalizedBulkCoding>(
+    _ source: UnsafeRawPointer
+    ) -> T
+{
+    var value = T()
+    withUnsafeMutableBytes(of: &value) { (bytes) in
+        bytes.baseAddress!
+            .copyBytes(from: source, count: MemoryLayout<T>.size)
+    }
+    return value
+}
+
+internal func _platformWidthScalarSizeError(_ size: Int, for key: String)
+    -> ObjCNormalizedCodingDecodeError
+{
+    return ObjCNormalizedCodingDecodeError.internalInconsistency(
+        key: key,
+        explanation: "The bulk coded buffer for key(\"\(key)\") has platform-width scalars of \(size) bytes, which is neither 32-bit nor 64-bit."
+    )
+}
+
+internal func _platformWidthScalarOverflowError<T>(
+    _ value: T, for key: String
+    ) -> ObjCNormalizedCodingDecodeError
+{
+    return ObjCNormalizedCodingDecodeError.internalInconsistency(
+        key: key,
+        explanation: "The bulk coded buffer for key(\"\(key)\") has a platform-width scalar(\(value)) which overflows this platform."
+    )
+}
+
+private let _bulkCodingMagic: UInt32 = 0x4254_534E // "NSTB"
+
+private let _bulkCodingHeaderSize = 16
+
+/// The elements are made of platform-width scalars.
+private let _bulkCodingFlagPlatformWidth: UInt16 = 1 << 0
+
+private let _isHostLittleEndian = 1.littleEndian == 1
+
+/// Makes a bulk coded buffer of `elements`.
+internal func _makeBulkCodedData<T: ObjCNormalizedBulkCoding>(
+    _ elements: UnsafeBufferPointer<T>
+    ) -> Data
+{
+    let elementSize = MemoryLayout<T>.stride
+    let count = elements.count
+    let flags = T.self is _ObjCNormalizedPlatformWidthBulkCoding.Type
+        ? _bulkCodingFlagPlatformWidth : 0
+    
+    var data = Data(count: _bulkCodingHeaderSize + elementSize * count)
+    
+    data.withUnsafeMutableBytes { (bytes: UnsafeMutablePointer<UInt8>) in
+        let header = UnsafeMutableRawPointer(bytes)
+        
+        header.storeBytes(
+            of: _bulkCodingMagic.littleEndian, as: UInt32.self
+        )
+        header.storeBytes(
+            of: UInt16(elementSize).littleEndian, toByteOffset: 4,
+            as: UInt16.self
+        )
+        header.storeBytes(
+            of: flags.littleEndian, toByteOffset: 6, as: UInt16.self
+        )
+        header.storeBytes(
+            of: UInt64(count).littleEndian, toByteOffset: 8,
+            as: UInt64.self
+        )
+        
+        guard let base = elements.baseAddress, count > 0 else { return }
+        
+        let payload = header + _bulkCodingHeaderSize
+        
+        if _isHostLittleEndian {
+            payload.copyBytes(from: base, count: elementSize * count)
+        } else {
+            for index in 0..<count {
+                payload.storeBytes(
+                    of: base[index].littleEndian,
+                    toByteOffset: index * elementSize,
+                    as: T.self
+                )
+            }
+        }
+    }
+    
+    return data
+}
+
+/// A validated view of a bulk coded buffer of `T`.
+internal struct _BulkCodedElements<T: ObjCNormalizedBulkCoding> {
+    internal let count: Int
+    
+    private let _elementSize: Int
+    
+    private let _payload: UnsafeRawPointer
+    
+    /// Returns `nil` when `bytes` is not a bulk coded buffer. Throws when
+    /// it is one but its elements cannot be decoded as `T`.
+    internal init?(bytes: UnsafeRawPointer, length: Int, for key: String)
+        throws
+    {
+        guard length >= _bulkCodingHeaderSize,
+            UInt32(littleEndian: _loadUnaligned(bytes)) == _bulkCodingMagic
+            else { return nil }
+        
+        let elementSize = Int(UInt16(littleEndian: _loadUnaligned(bytes + 4)))
+        let flags = UInt16(littleEndian: _loadUnaligned(bytes + 6))
+        let count = UInt64(littleEndian: _loadUnaligned(bytes + 8))
+        
+        if elementSize != MemoryLayout<T>.stride {
+            guard flags & _bulkCodingFlagPlatformWidth != 0,
+                let platformWidthType
+                = T.self as? _ObjCNormalizedPlatformWidthBulkCoding.Type,
+                elementSize % platformWidthType._platformWidthScalarCount
+                    == 0 else {
+                throw ObjCNormalizedCodingDecodeError.internalInconsistency(
+                    key: key,
+                    explanation: "The bulk coded buffer for key(\"\(key)\") has elements of \(elementSize) bytes but \(T.self) is of \(MemoryLayout<T>.stride) bytes."
+                )
+            }
+        }
+        
+        guard elementSize > 0,
+            count <= UInt64(Int.max / elementSize),
+            length == _bulkCodingHeaderSize + elementSize * Int(count)
+            else {
+            throw ObjCNormalizedCodingDecodeError.internalInconsistency(
+                key: key,
+                explanation: "The bulk coded buffer for key(\"\(key)\") is of \(length) bytes which doesn't match its \(count) elements."
+            )
+        }
+        
+        self.count = Int(count)
+        _elementSize = elementSize
+        _payload = bytes + _bulkCodingHeaderSize
+    }
+    
+    /// The elements in place when they can be used without any conversion.
+    internal var inPlaceElements: UnsafeBufferPointer<T>? {
+        guard _isHostLittleEndian,
+            _elementSize == MemoryLayout<T>.stride,
+            Int(bitPattern: _payload) % MemoryLayout<T>.alignment == 0
+            else { return nil }
+        return UnsafeBufferPointer(
+            start: _payload.assumingMemoryBound(to: T.self), count: count
+        )
+    }
+    
+    /// Initializes the uninitialized memory of `count` elements at
+    /// `elements` with the decoded elements.
+    internal func initialize(
+        _ elements: UnsafeMutablePointer<T>, for key: String
+        ) throws
+    {
+        guard count > 0 else { return }
+        
+        let destination = UnsafeMutableRawPointer(elements)
+        
+        if _elementSize == MemoryLayout<T>.stride {
+            destination.copyBytes(from: _payload, count: _elementSize * count)
+            
+            if !_isHostLittleEndian {
+                for index in 0..<count {
+                    elements[index] = T(littleEndian: elements[index])
+                }
+            }
+        } else {
+            // Checked by the initializer.
+            let platformWidthType
+                = T.self as! _ObjCNormalizedPlatformWidthBulkCoding.Type
+            let scalarCount
+                = platformWidthType._platformWidthScalarCount * count
+            let storedScalarSize
+                = _elementSize / platformWidthType._platformWidthScalarCount
+            let nativeScalarSize = MemoryLayout<T>.stride
+                / platformWidthType._platformWidthScalarCount
+            
+            for index in 0..<scalarCount {
+                try platformWidthType._convertPlatformWidthScalar(
+                    from: _payload + index * storedScalarSize,
+                    size: storedScalarSize,
+                    to: destination + index * nativeScalarSize,
+                    for: key
+                )
+            }
+        }
+    }
+}
+
+/// Appends the elements of a bulk coded buffer to `collection`. Returns
+/// `false` when `bytes` is not a bulk coded buffer.
+internal func _appendBulkCodedElements<
+    T: ObjCNormalizedBulkCoding, C: RangeReplaceableCollection
+    >(
+    from bytes: UnsafeRawPointer, length: Int, to collection: inout C,
+    for key: String
+    ) throws -> Bool where C.Iterator.Element == T
+{
+    guard let elements = try _BulkCodedElements<T>(
+        bytes: bytes, length: length, for: key
+        ) else { return false }
+    
+    collection.reserveCapacity(numericCast(elements.count))
+    
+    guard elements.count > 0 else { return true }
+    
+    if let inPlaceElements = elements.inPlaceElements {
+        collection.append(contentsOf: inPlaceElements)
+    } else {
+        let buffer = UnsafeMutablePointer<T>.allocate(capacity: elements.count)
+        defer { buffer.deallocate(capacity: elements.count) }
+        
+        try elements.initialize(buffer, for: key)
+        
+        collection.append(
+            contentsOf: UnsafeBufferPointer(start: buffer, count: elements.count)
+        )
+    }
+    
+    return true
+}
@@ -46,12 +46,12 @@ public protocol ObjCProtocolMessageIntercepting: NSObjectProtocol {
 extension ObjCProtocolMessageIntercepting {
     /// Returns registered intercepted protocols
     public var interceptedProtocols: [Protocol] {
-        return _interceptedProtocols.allObjects
+        return _interceptingState.interceptedProtocols
     }
     
     /// Returns registered protocol dispatching destination
     public var dispatchDestinations: [NSObjectProtocol] {
-        return _destinations.flatMap { $0.value }
+        return _interceptingState.destinations.flatMap { $0.value }
     }
     
     /// Returns the object to which unrecognized messages should firstly 
@@ -65,22 +65,25 @@ extension ObjCProtocolMessageIntercepting {
     public func nest_forwardingTarget(for aSelector: Selector)
         -> AnyObject?
     {
-        if let target = _dispatchAndCacheMessage(aSelector) {
+        switch _interceptingState.dispatch(aSelector, of: self) {
+        case let .resolved(target):
             #if DEBUG
                 if isDebugLoggingEnabled {
                     NSLog("\(self): Forwarding-Target for \(NSStringFromSelector(aSelector)): \(target).")
                 }
             #endif
             return target
-        }
-        
-        if class_respondsToSelector(type(of: self), aSelector) {
-            #if DEBUG
-                if isDebugLoggingEnabled {
-                    NSLog("\(self): Forwarding-Target for \(NSStringFromSelector(aSelector)): self.")
-                }
-            #endif
-            return self
+        case .unresolved:
+            break
+        case .notIntercepted:
+            if class_respondsToSelector(type(of: self), aSelector) {
+                #if DEBUG
+                    if isDebugLoggingEnabled {
+                        NSLog("\(self): Forwarding-Target for \(NSStringFromSelector(aSelector)): self.")
+                    }
+                #endif
+                return self
+            }
         }
         
         #if DEBUG
@@ -101,33 +104,30 @@ extension ObjCProtocolMessageIntercepting {
     /// implementation in any conformed type; 2) Extension shall always 
     /// extend new members and never override existed members.
     public func nest_responds(to aSelector: Selector) -> Bool {
-        if _dispatchAndCacheMessage(aSelector) != nil {
-            #if DEBUG
-                if isDebugLoggingEnabled {
-                    NSLog("\(self): Responds to \(NSStringFromSelector(aSelector)).")
-                }
-            #endif
-            return true
+        let responds: Bool
+        
+        switch _interceptingState.dispatch(aSelector, of: self) {
+        case .resolved:         responds = true
+        case .unresolved:       responds = false
+        case .notIntercepted:
+            responds = class_respondsToSelector(type(of: self), aSelector)
         }
         
-        let superSuggestion = class_respondsToSelector(type(of: self), aSelector)
         #if DEBUG
             if isDebugLoggingEnabled {
-                if superSuggestion {
+                if responds {
                     NSLog("\(self): Responds to \(NSStringFromSelector(aSelector)).")
                 } else {
                     NSLog("\(self): NOT Responds to \(NSStringFromSelector(aSelector)).")
                 }
             }
         #endif
-        return superSuggestion
+        return responds
     }
     
     /// Add an intercepted protocol.
     public func addInterceptedProtocol(_ interceptedProtocol: Protocol) {
-        if !_interceptedProtocols.contains(interceptedProtocol) {
-            _interceptedProtocols.add(interceptedProtocol)
-        }
+        _interceptingState.addInterceptedProtocol(interceptedProtocol)
         if !class_conformsToProtocol(
             type(of: self), interceptedProtocol
             )
@@ -141,14 +141,7 @@ extension ObjCProtocolMessageIntercepting {
         _ interceptedProtocols: Protocol...
         )
     {
-        for eachProtocol in interceptedProtocols {
-            if !_interceptedProtocols.contains(eachProtocol) {
-                _interceptedProtocols.add(eachProtocol)
-            }
-            if !class_conformsToProtocol(type(of: self), eachProtocol) {
-                class_addProtocol(type(of: self), eachProtocol)
-            }
-        }
+        addInterceptedProtocols(interceptedProtocols)
     }
     
     /// Add a sequence of intercepted protocols.
@@ -157,12 +150,7 @@ extension ObjCProtocolMessageIntercepting {
         ) where S.Iterator.Element == Protocol
     {
         for eachProtocol in interceptedProtocols {
-            if !_interceptedProtocols.contains(eachProtocol) {
-                _interceptedProtocols.add(eachProtocol)
-            }
-            if !class_conformsToProtocol(type(of: self), eachProtocol) {
-                class_addProtocol(type(of: self), eachProtocol)
-            }
+            addInterceptedProtocol(eachProtocol)
         }
     }
     
@@ -171,8 +159,9 @@ extension ObjCProtocolMessageIntercepting {
         _ dispatchDestination: NSObjectProtocol
         )
     {
-        _destinations.append(Weak(dispatchDestination))
-        _setNeedsInvalidateDispatchTable()
+        let state = _interceptingState
+        state.destinations.append(Weak(dispatchDestination))
+        state.invalidateDispatchTable()
     }
     
     /// Append a protocol dispatch destination.
@@ -180,10 +169,11 @@ extension ObjCProtocolMessageIntercepting {
         _ dispatchDestinations: S
         ) where S.Iterator.Element == NSObjectProtocol
     {
-        _destinations.append(
+        let state = _interceptingState
+        state.destinations.append(
             contentsOf: dispatchDestinations.map {Weak($0)}
         )
-        _setNeedsInvalidateDispatchTable()
+        state.invalidateDispatchTable()
     }
     
     @discardableResult
@@ -192,249 +182,151 @@ extension ObjCProtocolMessageIntercepting {
         )
         -> NSObjectProtocol?
     {
-        _setNeedsInvalidateDispatchTable()
-        return _destinations.remove(Weak(dispatchDestination))?.value
+        let state = _interceptingState
+        state.invalidateDispatchTable()
+        return state.destinations.remove(Weak(dispatchDestination))?.value
     }
     
     @discardableResult
     public func removeDispatchDestination(at index: Int)
         -> NSObjectProtocol?
     {
-        _setNeedsInvalidateDispatchTable()
-        return _destinations.remove(at: index).value
+        let state = _interceptingState
+        state.invalidateDispatchTable()
+        return state.destinations.remove(at: index).value
     }
     
     public func insertDispatchDestination(
         _ dispatchDestination: NSObjectProtocol, at index: Int
         )
     {
-        _destinations.insert(Weak(dispatchDestination), at: index)
-        _setNeedsInvalidateDispatchTable()
+        let state = _interceptingState
+        state.destinations.insert(Weak(dispatchDestination), at: index)
+        state.invalidateDispatchTable()
     }
     
-    // MARK: Dispatch the Message
-    private func _dispatchAndCacheMessage(_ message: Selector)
-        -> NSObjectProtocol?
-    {
-        let needsDispatch = _doesSelectorBelongToAnyDispatchedProtocol(
-            message
-        )
-        
-        let selString = NSStringFromSelector(message) as NSString
-        
-        var emptyDestinationIndices = [Int]()
-        
-        defer {
-            _destinations.remove(indices: emptyDestinationIndices)
-        }
-        
-        if needsDispatch {
-            _invalidateDispatchTableIfNeeded()
-            
-            if let cachedDest = _dispatchTable.object(forKey: selString) {
-                if cachedDest is NSNull {
-                    #if DEBUG
-                        if isDebugLoggingEnabled {
-                            NSLog("\(self): Dispatch \(selString) to nil.")
-                        }
-                    #endif
-                    return nil
-                }
-                #if DEBUG
-                    if isDebugLoggingEnabled {
-                        NSLog("\(self): Dispatch \(selString) to \(cachedDest).")
-                    }
-                #endif
-                return cachedDest
-            }
-            
-            for (idx, destWrapper) in _destinations.enumerated() {
-                if let dest = destWrapper.value {
-                    if dest.responds(to: message) {
-                        _dispatchTable.setObject(dest, forKey: selString)
-                        #if DEBUG
-                            if isDebugLoggingEnabled {
-                                NSLog("\(self): Dispatch \(selString) to \(dest).")
-                            }
-                        #endif
-                        return dest
-                    }
-                } else {
-                    emptyDestinationIndices.append(idx)
-                }
-            }
-            
-            if class_respondsToSelector(type(of: self), message) {
-                _dispatchTable.setObject(self, forKey: selString)
-                #if DEBUG
-                    if isDebugLoggingEnabled {
-                        NSLog("\(self): Dispatch \(selString) to self.")
-                    }
-                #endif
-                return self
-            }
-            
-            _dispatchTable.setObject(NSNull(), forKey: selString)
-            #if DEBUG
-                if isDebugLoggingEnabled {
-                    NSLog("\(self): Dispatch \(selString) to nil.")
-                }
-            #endif
-            return nil
+    // MARK: Stored Properties
+    private var _interceptingState: _ObjCProtocolMessageInterceptingState {
+        if let state = objc_getAssociatedObject(
+            self,
+            &interceptingStateKey
+            )
+            as? _ObjCProtocolMessageInterceptingState
+        {
+            return state
+        } else {
+            let initVal = _ObjCProtocolMessageInterceptingState()
+            objc_setAssociatedObject(
+                self,
+                &interceptingStateKey,
+                initVal,
+                .OBJC_ASSOCIATION_RETAIN_NONATOMIC
+            )
+            return initVal
         }
-        
-        return nil
     }
-    
-    private func _setNeedsInvalidateDispatchTable() {
-        if !_needsInvalidateDispatchTable {
-            _needsInvalidateDispatchTable = true
-            RunLoop.main.schedule { [weak self] in
-                self?._invalidateDispatchTableIfNeeded()
-            }
-        }
+}
+
+/// Holds intercepted protocols, dispatch destinations and the dispatch table
+/// of an `ObjCProtocolMessageIntercepting` conformed object.
+private final class _ObjCProtocolMessageInterceptingState {
+    enum DispatchResult {
+        /// The selector doesn't belong to any intercepted protocol.
+        case notIntercepted
+        /// Neither any dispatch destination nor the object itself responds.
+        case unresolved
+        case resolved(NSObjectProtocol)
     }
     
-    private var _needsInvalidateDispatchTable: Bool {
-        get {
-            if let value = objc_getAssociatedObject(
-                self,
-                &needsInvalidateDispatchTableKey
-                )
-                as? Bool
-            {
-                return value
-            } else {
-                return false
-            }
-        }
-        set {
-            let oldValue = _needsInvalidateDispatchTable
-            if oldValue != newValue {
-                objc_setAssociatedObject(
-                    self,
-                    &needsInvalidateDispatchTableKey,
-                    newValue,
-                    .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-                )
-            }
-            
-        }
+    private enum _DispatchTableEntryKind {
+        case notIntercepted
+        case unresolved
+        case resolved(Weak<NSObjectProtocol>)
     }
     
-    private func _invalidateDispatchTableIfNeeded() {
-        if _needsInvalidateDispatchTable {
-            if _dispatchTable.count > 0 {
-                _dispatchTable.removeAllObjects()
-            }
-            _needsInvalidateDispatchTable = false
-        }
+    private struct _DispatchTableEntry {
+        let generation: Int
+        let kind: _DispatchTableEntryKind
     }
     
-    // MARK: Stored Properties
-    private var _interceptedProtocols: NSHashTable<Protocol> {
-        get {
-            if let protocols = objc_getAssociatedObject(
-                self,
-                &interceptedProtocolsKey
-                )
-                as? NSHashTable<Protocol>
-            {
-                return protocols
-            } else {
-                let initVal = NSHashTable<Protocol>()
-                objc_setAssociatedObject(
-                    self,
-                    &interceptedProtocolsKey,
-                    initVal,
-                    .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-                )
-                return initVal
-            }
-        }
-        set {
-            objc_setAssociatedObject(
-                self,
-                &interceptedProtocolsKey,
-                newValue,
-                .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-            )
+    private(set) var interceptedProtocols: [Protocol] = []
+    
+    var destinations: [Weak<NSObjectProtocol>] = []
+    
+    /// Entries resolved in previous generations are stale.
+    private var _dispatchTable: [Selector : _DispatchTableEntry] = [:]
+    
+    private var _generation: Int = 0
+    
+    func addInterceptedProtocol(_ aProtocol: Protocol) {
+        if !interceptedProtocols.contains(where: { $0 === aProtocol }) {
+            interceptedProtocols.append(aProtocol)
+            invalidateDispatchTable()
         }
     }
     
-    private var _destinations: [Weak<NSObjectProtocol>] {
-        get {
-            if let destinations = objc_getAssociatedObject(
-                self,
-                &destinationsKey
-                )
-                as? [Weak<NSObjectProtocol>]
-            {
-                return destinations
-            } else {
-                let initVal = [Weak<NSObjectProtocol>]()
-                objc_setAssociatedObject(
-                    self,
-                    &destinationsKey,
-                    initVal,
-                    .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-                )
-                return initVal
-            }
-        }
-        set {
-            objc_setAssociatedObject(
-                self,
-                &destinationsKey,
-                newValue,
-                .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-            )
-        }
+    func invalidateDispatchTable() {
+        _generation += 1
     }
     
-    private var _dispatchTable: NSMapTable<NSString, NSObjectProtocol> {
-        get {
-            if let value = objc_getAssociatedObject(
-                self,
-                &dispatchTableKey
-                )
-                as? NSMapTable<NSString, NSObjectProtocol>
-            {
-                return value
-            } else {
-                let initVal: NSMapTable<NSString, NSObjectProtocol>
-                    = .strongToWeakObjects()
-                objc_setAssociatedObject(
-                    self,
-                    &dispatchTableKey,
-                    initVal,
-                    .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-                )
-                return initVal
+    func dispatch(_ aSelector: Selector, of object: NSObjectProtocol)
+        -> DispatchResult
+    {
+        if let entry = _dispatchTable[aSelector],
+            entry.generation == _generation
+        {
+            switch entry.kind {
+            case .notIntercepted:   return .notIntercepted
+            case .unresolved:       return .unresolved
+            case let .resolved(target):
+                if let targetValue = target.value {
+                    return .resolved(targetValue)
+                }
+                // The destination was deallocated.
+                destinations = destinations.filter { $0.value != nil }
+                invalidateDispatchTable()
             }
         }
-        set {
-            objc_setAssociatedObject(
-                self,
-                &dispatchTableKey,
-                newValue,
-                .OBJC_ASSOCIATION_RETAIN_NONATOMIC
-            )
+        
+        let result = _resolve(aSelector, of: object)
+        
+        let kind: _DispatchTableEntryKind
+        switch result {
+        case .notIntercepted:           kind = .notIntercepted
+        case .unresolved:               kind = .unresolved
+        case let .resolved(target):     kind = .resolved(Weak(target))
         }
+        
+        _dispatchTable[aSelector] = _DispatchTableEntry(
+            generation: _generation, kind: kind
+        )
+        
+        return result
     }
     
-    // MARK: Utilities
-    private func _doesSelectorBelongToAnyDispatchedProtocol(
-        _ aSelector: Selector
-        )
-        -> Bool
+    private func _resolve(_ aSelector: Selector, of object: NSObjectProtocol)
+        -> DispatchResult
     {
-        for eachProtocol in interceptedProtocols
-            where sel_belongsToProtocol(aSelector, eachProtocol)
+        guard interceptedProtocols.contains(where: {
+            sel_belongsToProtocol(aSelector, $0)
+        }) else
         {
-            return true
+            return .notIntercepted
+        }
+        
+        for eachDestination in destinations {
+            if let destination = eachDestination.value,
+                destination.responds(to: aSelector)
+            {
+                return .resolved(destination)
+            }
+        }
+        
+        if class_respondsToSelector(type(of: object), aSelector) {
+            return .resolved(object)
         }
-        return false
+        
+        return .unresolved
     }
 }
 
@@ -465,7 +357,4 @@ extension ObjCProtocolMessageIntercepting {
     private var isDebugLoggingEnabledKey = "isDebugLoggingEnabled"
 #endif
 
-private var interceptedProtocolsKey = "interceptedProtocols"
-private var destinationsKey = "destinations"
-private var dispatchTableKey = "dispatchTable"
-private var needsInvalidateDispatchTableKey = "needsInvalidateDispatchTable"
+private var interceptingStateKey = "interceptingState"
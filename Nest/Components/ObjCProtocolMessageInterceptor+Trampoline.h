@@ -0,0 +1,22 @@
+//
+//  ObjCProtocolMessageInterceptor+Trampoline.h
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Implements methods of the protocols `interceptorClass` conforms to with
+/// trampolines, which send messages straight to the resolved targets. Does
+/// nothing on architectures other than arm64 and x86_64.
+///
+/// - Notes: Only for `ObjCProtocolMessageInterceptor`'s dynamic subclasses.
+FOUNDATION_EXPORT void _ObjCProtocolMessageInterceptorInstallTrampolines(
+    Class interceptorClass
+);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,167 @@
+//
+//  ObjCProtocolMessageInterceptor+Trampoline.m
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+@import ObjectiveC;
+
+#import <Nest/Nest-Swift.h>
+
+#import "ObjCProtocolMessageInterceptor+Trampoline.h"
+
+#if defined(__arm64__) || defined(__x86_64__)
+#define OBJC_PROTOCOL_MESSAGE_INTERCEPTOR_USES_TRAMPOLINES 1
+#else
+#define OBJC_PROTOCOL_MESSAGE_INTERCEPTOR_USES_TRAMPOLINES 0
+#endif
+
+@interface ObjCProtocolMessageInterceptor (TrampolineTarget)
+/// Implemented in ObjCProtocolMessageInterceptor.swift
+- (nullable id)_trampolineTargetForSelector:(SEL)selector;
+@end
+
+#pragma mark - Functions Prototypes
+#if OBJC_PROTOCOL_MESSAGE_INTERCEPTOR_USES_TRAMPOLINES
+/// Implemented in ObjCProtocolMessageInterceptorTrampoline.s
+extern void ObjCProtocolMessageInterceptorTrampoline(void);
+
+__attribute__((visibility("hidden")))
+void * ObjCProtocolMessageInterceptorTrampolineTarget(
+    ObjCProtocolMessageInterceptor *,
+    SEL
+);
+
+static void ObjCProtocolMessageInterceptorInstallTrampolinesForProtocol(
+    Class,
+    Class,
+    Protocol *
+);
+
+static BOOL ObjCProtocolMessageInterceptorCanTrampoline(const char *);
+#endif
+
+#pragma mark - Trampoline Installation
+void _ObjCProtocolMessageInterceptorInstallTrampolines(Class interceptorClass) {
+#if OBJC_PROTOCOL_MESSAGE_INTERCEPTOR_USES_TRAMPOLINES
+    Class baseClass = [ObjCProtocolMessageInterceptor class];
+    
+    unsigned int protocolCount = 0;
+    Protocol * __unsafe_unretained * protocols
+    = class_copyProtocolList(interceptorClass, &protocolCount);
+    
+    for (unsigned int index = 0; index < protocolCount; index ++) {
+        ObjCProtocolMessageInterceptorInstallTrampolinesForProtocol(
+            interceptorClass, baseClass, protocols[index]
+        );
+    }
+    
+    free(protocols);
+#endif
+}
+
+#if OBJC_PROTOCOL_MESSAGE_INTERCEPTOR_USES_TRAMPOLINES
+#pragma mark - Functions Implementations
+/// Installs trampolines for methods of `protocol` and of the protocols it
+/// incorporates, such as `UIScrollViewDelegate` of `UITableViewDelegate`,
+/// which `protocol_copyMethodDescriptionList` doesn't list.
+static void ObjCProtocolMessageInterceptorInstallTrampolinesForProtocol(
+    Class interceptorClass,
+    Class baseClass,
+    Protocol * protocol
+    )
+{
+    for (int isRequired = 0; isRequired <= 1; isRequired ++) {
+        unsigned int methodCount = 0;
+        struct objc_method_description * methods
+        = protocol_copyMethodDescriptionList(
+            protocol, isRequired, YES, &methodCount
+        );
+        
+        for (unsigned int methodIndex = 0;
+             methodIndex < methodCount;
+             methodIndex ++)
+        {
+            SEL selector = methods[methodIndex].name;
+            const char * types = methods[methodIndex].types;
+            
+            // Methods implemented by the interceptor itself, such as
+            // those of `NSObject`, are kept.
+            if (class_getInstanceMethod(baseClass, selector) != NULL) {
+                continue;
+            }
+            
+            if (!ObjCProtocolMessageInterceptorCanTrampoline(types)) {
+                continue;
+            }
+            
+            // Does nothing for methods listed by more than one protocol.
+            class_addMethod(
+                interceptorClass,
+                selector,
+                (IMP)ObjCProtocolMessageInterceptorTrampoline,
+                types
+            );
+        }
+        
+        free(methods);
+    }
+    
+    unsigned int incorporatedProtocolCount = 0;
+    Protocol * __unsafe_unretained * incorporatedProtocols
+    = protocol_copyProtocolList(protocol, &incorporatedProtocolCount);
+    
+    for (unsigned int index = 0; index < incorporatedProtocolCount; index ++) {
+        ObjCProtocolMessageInterceptorInstallTrampolinesForProtocol(
+            interceptorClass, baseClass, incorporatedProtocols[index]
+        );
+    }
+    
+    free(incorporatedProtocols);
+}
+
+void * ObjCProtocolMessageInterceptorTrampolineTarget(
+    ObjCProtocolMessageInterceptor * self,
+    SEL _cmd
+    )
+{
+    // Not retained: the target is only kept alive by its owners until the
+    // trampoline's tail call. Thus the interceptor shall only be messaged on
+    // the thread which owns its targets. See ObjCProtocolMessageInterceptor.
+    return (__bridge void *)[self _trampolineTargetForSelector:_cmd];
+}
+
+static BOOL ObjCProtocolMessageInterceptorCanTrampoline(const char * types) {
+#if defined(__x86_64__)
+    NSMethodSignature * signature
+    = [NSMethodSignature signatureWithObjCTypes:types];
+    
+    const char * returnType = signature.methodReturnType;
+    
+    while (*returnType == 'r' || *returnType == 'n' || *returnType == 'N'
+           || *returnType == 'o' || *returnType == 'O' || *returnType == 'R'
+           || *returnType == 'V')
+    {
+        returnType ++;
+    }
+    
+    // Returned in memory, which requires objc_msgSend_stret.
+    if ((*returnType == '{' || *returnType == '(')
+        && signature.methodReturnLength > 16)
+    {
+        return NO;
+    }
+    
+    // Returned in x87 registers, which requires objc_msgSend_fpret.
+    if (*returnType == 'D') {
+        return NO;
+    }
+    
+    return YES;
+#else
+    return YES;
+#endif
+}
+#endif
@@ -8,6 +8,7 @@
 
 import Foundation
 import SwiftExt
+import Nest.ObjCProtocolMessageInterceptorTrampoline
 
 /// `ObjCProtocolMessageInterceptor` is a proxy which intercepts messages 
 /// which originally intended to be sent to the receiver to the middle 
@@ -15,14 +16,20 @@ import SwiftExt
 ///
 /// - Notes: `ObjCProtocolMessageInterceptor` is a class cluster which 
 /// dynamically subclasses itself to conform to the intercepted protocols 
-/// at the runtime.
+/// at the runtime. On arm64 and x86_64, the subclass implements intercepted
+/// methods with trampolines which send messages straight to the resolved
+/// targets, and the forwarding machinery is only used as a fallback.
+///
+/// - Notes: `ObjCProtocolMessageInterceptor` is not thread-safe. Message it
+/// only on the thread which owns the receiver and the middle men, such as
+/// the main thread for UIKit delegates, since targets are not retained
+/// while a message is being sent to them.
 ///
 /// - See Also: ObjCProtocolMessageIntercepting
 public final class ObjCProtocolMessageInterceptor: NSObject {
     @objc
     private init(interceptedProtocols: [Protocol]) {
         self.interceptedProtocols = interceptedProtocols
-        _dispatchTable = NSMapTable.strongToWeakObjects()
     }
     
     //MARK: Create ObjCProtocolMessageInterceptor
@@ -159,6 +166,8 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
             
             objc_registerClassPair(subclass)
             
+            _ObjCProtocolMessageInterceptorInstallTrampolines(subclass)
+            
             return subclass
         }
     }
@@ -200,6 +209,17 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
             return true
         }
         
+        // Intercepted methods might be implemented with trampolines, which
+        // does not mean the receiver responds.
+        if case .unresolved? = _dispatchTable[aSelector] {
+            #if DEBUG
+                if shouldLogMessageResponding {
+                    print(#function, aSelector, "->", false)
+                }
+            #endif
+            return false
+        }
+        
         let doesRespond = super.responds(to: aSelector)
         #if DEBUG
             if shouldLogMessageResponding {
@@ -297,7 +317,7 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
     }
     
     private func invaldiateDispatchTableIfNeeded() {
-        _dispatchTable.removeAllObjects()
+        _dispatchTable.removeAll(keepingCapacity: true)
         _needsInvalidateDispatchTable = false
     }
     
@@ -315,8 +335,43 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
         return false
     }
     
+    /// Called by trampolines. A nil target makes the message return zero.
+    @objc(_trampolineTargetForSelector:)
+    private func _trampolineTarget(for aSelector: Selector) -> AnyObject? {
+        return _dispatchAndCache(message: aSelector)
+    }
+    
     private func _dispatchAndCache(message: Selector)
         -> NSObjectProtocol?
+    {
+        switch _dispatchTable[message] {
+        case .notIntercepted?, .unresolved?:
+            return nil
+        case let .resolved(target)?:
+            if let target = target.value {
+                return target
+            }
+            // The target was deallocated, resolves again.
+        case nil:
+            guard _doesSelectorBelongToAnyInterceptedProtocol(message) else {
+                _dispatchTable[message] = .notIntercepted
+                return nil
+            }
+        }
+        
+        let target = _resolveTarget(for: message)
+        
+        if let target = target {
+            _dispatchTable[message] = .resolved(Weak(target))
+        } else {
+            _dispatchTable[message] = .unresolved
+        }
+        
+        return target
+    }
+    
+    private func _resolveTarget(for message: Selector)
+        -> NSObjectProtocol?
     {
         var emptyMiddleManWrappersIndices = [Int]()
         
@@ -324,61 +379,37 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
             _middleMen.remove(indices: emptyMiddleManWrappersIndices)
         }
         
-        let needsDisaptch = _doesSelectorBelongToAnyInterceptedProtocol(
-            message
-        )
-        
-        let msgKey = NSStringFromSelector(message) as NSString
-        
-        if needsDisaptch {
-            if let cached = _dispatchTable.object(forKey: msgKey) {
-                if cached is NSNull {
-                    return nil
-                } else {
-                    return cached
-                }
-            }
-            
-            for (idx, middleManWrapper) in _middleMen.enumerated() {
-                if let middleMan = middleManWrapper.value {
-                    if middleMan.responds(to: message) {
-                        _dispatchTable.setObject(
-                            middleMan, forKey: msgKey
-                        )
-                        #if DEBUG
-                            if shouldLogMessageDispatching {
-                                print("\(self) dispatched \"\(NSStringFromSelector(message))\" to middle man: \(middleMan).")
-                            }
-                        #endif
-                        return middleMan
-                    }
-                } else {
-                    emptyMiddleManWrappersIndices.append(idx)
+        for (idx, middleManWrapper) in _middleMen.enumerated() {
+            if let middleMan = middleManWrapper.value {
+                if middleMan.responds(to: message) {
+                    #if DEBUG
+                        if shouldLogMessageDispatching {
+                            print("\(self) dispatched \"\(NSStringFromSelector(message))\" to middle man: \(middleMan).")
+                        }
+                    #endif
+                    return middleMan
                 }
+            } else {
+                emptyMiddleManWrappersIndices.append(idx)
             }
-            
-            if let receiver = receiver,
-                receiver.responds(to: message) == true
-            {
-                _dispatchTable.setObject(receiver, forKey: msgKey)
-                #if DEBUG
-                    if shouldLogMessageDispatching {
-                        print("\(self) dispatched \"\(NSStringFromSelector(message))\" to receiver: \(receiver).")
-                    }
-                #endif
-                return receiver
-            }
-            
-            _dispatchTable.setObject(NSNull(), forKey: msgKey)
+        }
+        
+        if let receiver = receiver,
+            receiver.responds(to: message) == true
+        {
             #if DEBUG
                 if shouldLogMessageDispatching {
-                    print("\(self) dispatched \"\(NSStringFromSelector(message))\" to nil.")
+                    print("\(self) dispatched \"\(NSStringFromSelector(message))\" to receiver: \(receiver).")
                 }
             #endif
-            return nil
+            return receiver
         }
         
-        
+        #if DEBUG
+            if shouldLogMessageDispatching {
+                print("\(self) dispatched \"\(NSStringFromSelector(message))\" to nil.")
+            }
+        #endif
         return nil
     }
     
@@ -394,7 +425,9 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
     public let interceptedProtocols: [Protocol]
     
     /// The receiver receives messages.
-    public weak var receiver: NSObjectProtocol?
+    public weak var receiver: NSObjectProtocol? {
+        didSet { invaldiateDispatchTableIfNeeded() }
+    }
     
     #if DEBUG
     public var shouldLogMessageDispatching: Bool = false
@@ -406,6 +439,14 @@ public final class ObjCProtocolMessageInterceptor: NSObject {
     
     private var _needsInvalidateDispatchTable: Bool = false
     
-    private var _dispatchTable: NSMapTable<NSString, NSObjectProtocol>
+    /// Caches the targets of messages, which are weakly held.
+    private var _dispatchTable: [Selector : _DispatchTableEntry] = [:]
+    
+    private enum _DispatchTableEntry {
+        case notIntercepted
+        /// Intercepted but no middle man nor the receiver responds.
+        case unresolved
+        case resolved(Weak<NSObjectProtocol>)
+    }
     
 }
@@ -0,0 +1,113 @@
+//
+//  ObjCProtocolMessageInterceptorTrampoline.s
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+/*
+ A trampoline is installed as the implementation of each intercepted
+ method. It saves the argument registers, asks the interceptor for the
+ target of the message, restores the arguments, and tail calls
+ objc_msgSend with the target as the receiver. Methods returning values
+ through memory on x86_64 (which needs objc_msgSend_stret) never get
+ trampolines. See ObjCProtocolMessageInterceptor+Trampoline.m
+ */
+
+#if defined(__arm64__)
+
+.text
+.align 2
+.private_extern _ObjCProtocolMessageInterceptorTrampoline
+.globl _ObjCProtocolMessageInterceptorTrampoline
+_ObjCProtocolMessageInterceptorTrampoline:
+    stp     fp, lr, [sp, #-16]!
+    mov     fp, sp
+    sub     sp, sp, #208
+    
+    stp     q0, q1, [sp, #0]
+    stp     q2, q3, [sp, #32]
+    stp     q4, q5, [sp, #64]
+    stp     q6, q7, [sp, #96]
+    stp     x0, x1, [sp, #128]
+    stp     x2, x3, [sp, #144]
+    stp     x4, x5, [sp, #160]
+    stp     x6, x7, [sp, #176]
+    // x8 holds the address of indirect results.
+    str     x8, [sp, #192]
+    
+    // x0 is self, x1 is _cmd.
+    bl      _ObjCProtocolMessageInterceptorTrampolineTarget
+    mov     x9, x0
+    
+    ldp     q0, q1, [sp, #0]
+    ldp     q2, q3, [sp, #32]
+    ldp     q4, q5, [sp, #64]
+    ldp     q6, q7, [sp, #96]
+    ldp     x0, x1, [sp, #128]
+    ldp     x2, x3, [sp, #144]
+    ldp     x4, x5, [sp, #160]
+    ldp     x6, x7, [sp, #176]
+    ldr     x8, [sp, #192]
+    
+    mov     x0, x9
+    mov     sp, fp
+    ldp     fp, lr, [sp], #16
+    
+    b       _objc_msgSend
+
+#elif defined(__x86_64__)
+
+.text
+.align 4
+.private_extern _ObjCProtocolMessageInterceptorTrampoline
+.globl _ObjCProtocolMessageInterceptorTrampoline
+_ObjCProtocolMessageInterceptorTrampoline:
+    pushq   %rbp
+    movq    %rsp, %rbp
+    subq    $192, %rsp
+    
+    movdqa  %xmm0, 0(%rsp)
+    movdqa  %xmm1, 16(%rsp)
+    movdqa  %xmm2, 32(%rsp)
+    movdqa  %xmm3, 48(%rsp)
+    movdqa  %xmm4, 64(%rsp)
+    movdqa  %xmm5, 80(%rsp)
+    movdqa  %xmm6, 96(%rsp)
+    movdqa  %xmm7, 112(%rsp)
+    movq    %rdi, 128(%rsp)
+    movq    %rsi, 136(%rsp)
+    movq    %rdx, 144(%rsp)
+    movq    %rcx, 152(%rsp)
+    movq    %r8, 160(%rsp)
+    movq    %r9, 168(%rsp)
+    // %rax holds the count of vector registers used by variadic calls.
+    movq    %rax, 176(%rsp)
+    
+    // %rdi is self, %rsi is _cmd.
+    call    _ObjCProtocolMessageInterceptorTrampolineTarget
+    movq    %rax, %r11
+    
+    movdqa  0(%rsp), %xmm0
+    movdqa  16(%rsp), %xmm1
+    movdqa  32(%rsp), %xmm2
+    movdqa  48(%rsp), %xmm3
+    movdqa  64(%rsp), %xmm4
+    movdqa  80(%rsp), %xmm5
+    movdqa  96(%rsp), %xmm6
+    movdqa  112(%rsp), %xmm7
+    movq    128(%rsp), %rdi
+    movq    136(%rsp), %rsi
+    movq    144(%rsp), %rdx
+    movq    152(%rsp), %rcx
+    movq    160(%rsp), %r8
+    movq    168(%rsp), %r9
+    movq    176(%rsp), %rax
+    
+    movq    %r11, %rdi
+    leave
+    
+    jmp     _objc_msgSend
+
+#endif
@@ -14,7 +14,9 @@ public final class ObjCSelectorMessageInterceptor: NSObject {
     public let interceptedSelectors: [Selector]
     
     /// The receiver receives messages.
-    public weak var receiver: NSObjectProtocol?
+    public weak var receiver: NSObjectProtocol? {
+        didSet { _generation += 1 }
+    }
     
     /// The middle men intercepts messages. The last middle appended man
     /// receives messages firstly.
@@ -23,34 +25,57 @@ public final class ObjCSelectorMessageInterceptor: NSObject {
         return _middleMen.flatMap {$0.value}
     }
     
+    private let _interceptedSelectorSet: Set<Selector>
+    
+    /// Caches resolved targets. Entries resolved in previous generations are
+    /// stale.
+    private var _resolvedTargets: [Selector : _ResolvedTarget] = [:]
+    
+    /// Increased when middle men or the receiver changed, or a resolved
+    /// target was deallocated.
+    private var _generation: Int = 0
+    
+    private struct _ResolvedTarget {
+        let generation: Int
+        /// `nil` when neither any middle man nor the receiver responds.
+        let target: Weak<NSObjectProtocol>?
+    }
+    
     public init(selector: Selector) {
         interceptedSelectors = [selector]
+        _interceptedSelectorSet = [selector]
     }
     
     public init(selectors: Selector...) {
         interceptedSelectors = selectors
+        _interceptedSelectorSet = Set(selectors)
     }
     
     public init<S: Sequence>(selectors: S) where
         S.Iterator.Element == Selector
     {
         interceptedSelectors = Array(selectors)
+        _interceptedSelectorSet = Set(interceptedSelectors)
     }
     
     public init(_ selectorLiteral: String) {
         interceptedSelectors = [Selector(selectorLiteral)]
+        _interceptedSelectorSet = Set(interceptedSelectors)
     }
     
     public init(_ selectorLiterals: String...) {
         interceptedSelectors = selectorLiterals.map { Selector($0) }
+        _interceptedSelectorSet = Set(interceptedSelectors)
     }
     
     public func add(middleMan: NSObjectProtocol) {
         _middleMen.append(Weak(middleMan))
+        _generation += 1
     }
     
     public func remove(middleMan: NSObjectProtocol) -> NSObjectProtocol? {
         if let index = _middleMen.index(of: Weak(middleMan)) {
+            _generation += 1
             return _middleMen.remove(at: index).value
         }
         return nil
@@ -63,7 +88,7 @@ public final class ObjCSelectorMessageInterceptor: NSObject {
     private func doesSelectorBelongToAnyInterceptedSelector(_ aSelector: Selector)
         -> Bool
     {
-        return interceptedSelectors.contains(aSelector)
+        return _interceptedSelectorSet.contains(aSelector)
     }
     
     /// Returns the object to which unrecognized messages should first be
@@ -71,24 +96,8 @@ public final class ObjCSelectorMessageInterceptor: NSObject {
     public override func forwardingTarget(for aSelector: Selector)
         -> Any?
     {
-        var emptyMiddleManWrappersIndices = [Int]()
-        
-        defer {
-            _middleMen.remove(indices: emptyMiddleManWrappersIndices)
-        }
-        
-        for (index, middleManWrapper) in _middleMen.reversed().enumerated() {
-            if middleManWrapper.value?.responds(to: aSelector) == true &&
-                doesSelectorBelongToAnyInterceptedSelector(aSelector)
-            {
-                return middleManWrapper.value
-            } else if middleManWrapper.value == nil {
-                emptyMiddleManWrappersIndices.append(index)
-            }
-        }
-        
-        if receiver?.responds(to: aSelector) == true {
-            return receiver
+        if let target = _resolvedTarget(for: aSelector) {
+            return target
         }
         
         return super.forwardingTarget(for: aSelector)
@@ -97,26 +106,59 @@ public final class ObjCSelectorMessageInterceptor: NSObject {
     /// Returns a Boolean value that indicates whether the receiver implements
     /// or inherits a method that can respond to a specified message.
     public override func responds(to aSelector: Selector) -> Bool {
-        var emptyMiddleManWrappersIndices = [Int]()
+        if _resolvedTarget(for: aSelector) != nil {
+            return true
+        }
         
-        defer {
-            _middleMen.remove(indices: emptyMiddleManWrappersIndices)
+        return super.responds(to: aSelector)
+    }
+    
+    /// Returns the cached target of `aSelector`, and resolves it again only
+    /// when the cache is stale.
+    private func _resolvedTarget(for aSelector: Selector)
+        -> NSObjectProtocol?
+    {
+        if let resolved = _resolvedTargets[aSelector],
+            resolved.generation == _generation
+        {
+            guard let target = resolved.target else { return nil }
+            
+            if let targetValue = target.value {
+                return targetValue
+            }
+            
+            // The target was deallocated.
+            _middleMen = _middleMen.filter { $0.value != nil }
+            _generation += 1
         }
         
-        for (index, eachMiddleMan) in _middleMen.reversed().enumerated() {
-            if eachMiddleMan.value?.responds(to: aSelector) == true &&
-                doesSelectorBelongToAnyInterceptedSelector(aSelector)
-            {
-                return true
-            } else if eachMiddleMan.value == nil {
-                emptyMiddleManWrappersIndices.append(index)
+        let target = _resolveTarget(for: aSelector)
+        
+        _resolvedTargets[aSelector] = _ResolvedTarget(
+            generation: _generation,
+            target: target.map { Weak($0) }
+        )
+        
+        return target
+    }
+    
+    private func _resolveTarget(for aSelector: Selector)
+        -> NSObjectProtocol?
+    {
+        if doesSelectorBelongToAnyInterceptedSelector(aSelector) {
+            for eachMiddleMan in _middleMen.reversed() {
+                if let middleMan = eachMiddleMan.value,
+                    middleMan.responds(to: aSelector)
+                {
+                    return middleMan
+                }
             }
         }
         
-        if receiver?.responds(to: aSelector) == true {
-            return true
+        if let receiver = receiver, receiver.responds(to: aSelector) {
+            return receiver
         }
         
-        return super.responds(to: aSelector)
+        return nil
     }
 }
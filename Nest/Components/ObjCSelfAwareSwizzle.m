@@ -19,7 +19,10 @@
 
 #pragma mark - Types
 typedef struct _ObjCSelfAwareSwizzleContext {
-    CFMutableDictionaryRef swizzledRecords;
+    /// Swizzles collected from all the Self-Aware Swizzle selectors, which
+    /// are performed in a batch once the Self-Aware Swizzle launch task
+    /// completed.
+    CFMutableArrayRef pendingSwizzles;
 } ObjCSelfAwareSwizzleContext;
 
 typedef NS_OPTIONS(NSUInteger, ObjCSelfAwareSwizzleSelectorMatchResult) {
@@ -32,6 +35,8 @@ typedef id (* ObjCSelfAwareSwizzleCombinationGetter)(id, SEL);
 
 #pragma mark - Functions Prototypes
 
+static void ObjCSelfAwareSwizzleCompletionHandler(void *);
+
 static void ObjCSelfAwareSwizzleContextCleanupHandler(void *);
 
 static void ObjCSelfAwareSwizzleSelectorHandler(
@@ -49,7 +54,7 @@ static void ObjCSelfAwareSwizzlePerformSwizzleCombination(
     const ObjCSelfAwareSwizzleContext *
 );
 
-static void ObjCSelfAwareSwizzlePerformSwizzle(
+static void ObjCSelfAwareSwizzleCollectSwizzle(
     ObjCSelfAwareSwizzle *,
     Class,
     const ObjCSelfAwareSwizzleContext *
@@ -66,10 +71,6 @@ static void ObjCSelfAwareSwizzlePerformSwizzles(
 static BOOL ObjCSelfAwareSwizzleDoesSelfAwareSelectorHostClassEqualToTargetClass(
     const Class, const Class
 );
-
-static NSString * ObjCSelfAwareSwizzleDescription(
-    const ObjCSelfAwareSwizzle *
-);
 #endif
 
 #pragma mark - Functions Implementations
@@ -77,13 +78,54 @@ void ObjCSelfAwareSwizzleContextCleanupHandler(void * context) {
     ObjCSelfAwareSwizzleContext * selfAwareContext =
         (ObjCSelfAwareSwizzleContext *)context;
     
-    if (selfAwareContext -> swizzledRecords) {
-        CFRelease(selfAwareContext -> swizzledRecords);
+    if (selfAwareContext -> pendingSwizzles) {
+        CFRelease(selfAwareContext -> pendingSwizzles);
     }
     
     free(selfAwareContext);
 }
 
+void ObjCSelfAwareSwizzleCompletionHandler(void * context) {
+    ObjCSelfAwareSwizzleContext * selfAwareContext =
+        (ObjCSelfAwareSwizzleContext *)context;
+    
+    NSArray<ObjCSelfAwareSwizzle *> * swizzles =
+        (__bridge NSArray<ObjCSelfAwareSwizzle *> *)
+        (selfAwareContext -> pendingSwizzles);
+    
+    if (swizzles.count == 0) {
+        return;
+    }
+    
+#if DEBUG
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+#endif
+    
+    NSInteger performedCount = 0;
+    NSError * error = nil;
+    
+    if ([ObjCSelfAwareSwizzle performSwizzles:swizzles
+                               performedCount:&performedCount
+                                        error:&error])
+    {
+#if DEBUG
+        NSLog(@"%ld Self-Aware Swizzles (%ld collected) performed in %f seconds.",
+              (long)performedCount,
+              (long)swizzles.count,
+              CFAbsoluteTimeGetCurrent() - start);
+#endif
+    } else {
+        // Reported in release builds as well, since no swizzle was
+        // performed.
+        NSLog(@"Self-Aware Swizzle FAILED due to error: %@ No class was swizzled.",
+              error.localizedDescription);
+        NSCAssert(NO, @"Self-Aware Swizzle FAILED due to error: %@",
+                  error.localizedDescription);
+    }
+    
+    CFArrayRemoveAllValues(selfAwareContext -> pendingSwizzles);
+}
+
 void ObjCSelfAwareSwizzleSelectorHandler(
     SEL selector,
     id owner,
@@ -150,7 +192,7 @@ void ObjCSelfAwareSwizzlePerformSwizzleCombination(
         ObjCSelfAwareSwizzle * swizzle =
             (ObjCSelfAwareSwizzle *)swizzleCombination;
         
-        ObjCSelfAwareSwizzlePerformSwizzle(
+        ObjCSelfAwareSwizzleCollectSwizzle(
             swizzle,
             cls,
             ctx
@@ -172,17 +214,17 @@ void ObjCSelfAwareSwizzlePerformSwizzleCombination(
 #endif
 }
 
-void ObjCSelfAwareSwizzlePerformSwizzle(
+void ObjCSelfAwareSwizzleCollectSwizzle(
     ObjCSelfAwareSwizzle * swizzle,
     Class aClass,
     const ObjCSelfAwareSwizzleContext * taskContext
     )
 {
+#if DEBUG
     Class targetClass = swizzle.targetClass;
     
     SEL targetSelector = swizzle.targetSelector;
     
-#if DEBUG
     if (!ObjCSelfAwareSwizzleDoesSelfAwareSelectorHostClassEqualToTargetClass(aClass, targetClass)) {
         NSLog(@"Class to be swizzled %@ is not the Self-Aware Swizzle selector's containing class %@.",
               NSStringFromClass(targetClass),
@@ -198,102 +240,11 @@ void ObjCSelfAwareSwizzlePerformSwizzle(
     }
 #endif
     
-    CFMutableDictionaryRef swizzledRecordsForClass = (CFMutableDictionaryRef)
-    CFDictionaryGetValue(
-        taskContext -> swizzledRecords,
-        (__bridge const void *)(targetClass)
+    // Validation and deduplication happen when the batch is performed.
+    CFArrayAppendValue(
+        taskContext -> pendingSwizzles,
+        (__bridge const void *)(swizzle)
     );
-    
-    if (swizzledRecordsForClass == NULL) {
-        swizzledRecordsForClass = CFDictionaryCreateMutable(
-            kCFAllocatorDefault,
-            0,
-            NULL,
-            &kCFTypeDictionaryValueCallBacks
-        );
-        
-        CFDictionarySetValue(
-            taskContext -> swizzledRecords,
-            (__bridge const void *)(targetClass),
-            swizzledRecordsForClass
-        );
-        
-        CFRelease(swizzledRecordsForClass);
-    }
-    
-    CFMutableArrayRef performedSwizzles = (CFMutableArrayRef)
-        CFDictionaryGetValue(swizzledRecordsForClass, targetSelector);
-    
-    if (performedSwizzles == NULL) {
-        performedSwizzles = CFArrayCreateMutable(
-            kCFAllocatorDefault,
-            0,
-            &kCFTypeArrayCallBacks
-        );
-        
-        CFDictionarySetValue(
-            swizzledRecordsForClass,
-            targetSelector,
-            performedSwizzles
-        );
-        
-        CFRelease(performedSwizzles);
-    }
-    
-    BOOL noEqualPerformedSwizzle = YES;
-    
-    CFIndex numberOfSwizzles = CFArrayGetCount(performedSwizzles);
-    
-    // Check duplicate
-    for (CFIndex index = 0; index < numberOfSwizzles; index ++) {
-        ObjCSelfAwareSwizzle * performedSwizzle =
-            CFArrayGetValueAtIndex(performedSwizzles, index);
-        
-        if ([performedSwizzle isEqual:swizzle]) {
-            noEqualPerformedSwizzle = NO;
-            break;
-        }
-    }
-    
-    if (noEqualPerformedSwizzle) {
-        Method targetMethod = class_getInstanceMethod(
-            targetClass,
-            targetSelector
-        );
-        
-        struct objc_method_description * targetMethodDescription =
-        method_getDescription(targetMethod);
-        
-        if (targetMethodDescription == NULL) {
-#if DEBUG
-            NSLog(@"Swizzling FAILED: Selector wasn't implemented: %@",
-                  ObjCSelfAwareSwizzleDescription(swizzle));
-#endif
-        } else {
-            NSError * error = nil;
-            
-            if ([swizzle perform:&error]) {
-                CFArrayAppendValue(
-                    performedSwizzles,
-                    (__bridge const void *)(swizzle)
-                );
-#if DEBUG
-                NSLog(@"Swizzle succeeded %@",
-                      ObjCSelfAwareSwizzleDescription(swizzle));
-#endif
-            } else {
-#if DEBUG
-                NSLog(@"Swizzle FAILED due to error: %@", error.description);
-#endif
-            }
-        }
-    }
-#if DEBUG
-    else {
-        NSLog(@"Swizzling FAILED: Duplicate swizzling: %@",
-              ObjCSelfAwareSwizzleDescription(swizzle));
-    }
-#endif
 }
 
 void ObjCSelfAwareSwizzlePerformSwizzles(
@@ -330,7 +281,7 @@ void ObjCSelfAwareSwizzlePerformSwizzles(
             if ([each isKindOfClass:[ObjCSelfAwareSwizzle class]]) {
                 ObjCSelfAwareSwizzle * swizzle
                     = (ObjCSelfAwareSwizzle *) each;
-                ObjCSelfAwareSwizzlePerformSwizzle(swizzle, cls, ctx);
+                ObjCSelfAwareSwizzleCollectSwizzle(swizzle, cls, ctx);
             } else if ([each conformsToProtocol:@protocol(NSFastEnumeration)]) {
                 NSObject <NSFastEnumeration> * swizzles
                     = (NSObject <NSFastEnumeration> *)each;
@@ -351,20 +302,6 @@ void ObjCSelfAwareSwizzlePerformSwizzles(
     }
 }
 
-#if DEBUG
-NSString * ObjCSelfAwareSwizzleDescription(ObjCSelfAwareSwizzle * swizzle) {
-    if (swizzle.isMetaClass) {
-        return [NSString stringWithFormat:@"[%@ +%@]",
-                NSStringFromClass(swizzle.targetClass),
-                NSStringFromSelector(swizzle.targetSelector)];
-    } else {
-        return [NSString stringWithFormat:@"[%@ -%@]",
-                NSStringFromClass(swizzle.targetClass),
-                NSStringFromSelector(swizzle.targetSelector)];
-    }
-}
-#endif
-
 #pragma mark - Register Self-Aware Swizzle as A Launch Task
 @interface NSObject(SelfAwareSwizzle)
 @end
@@ -376,18 +313,18 @@ NSString * ObjCSelfAwareSwizzleDescription(ObjCSelfAwareSwizzle * swizzle) {
         calloc(1, sizeof(ObjCSelfAwareSwizzleContext));
     
     // Initialize task context
-    contextRef -> swizzledRecords = CFDictionaryCreateMutable(
+    contextRef -> pendingSwizzles = CFArrayCreateMutable(
         kCFAllocatorDefault,
         0,
-        NULL,
-        &kCFTypeDictionaryValueCallBacks
+        &kCFTypeArrayCallBacks
     );
     
     // Register launch task info
-    LTRegisterLaunchTask(
+    LTRegisterLaunchTaskWithCompletionHandler(
         "_ObjCSelfAwareSwizzle_",
         &ObjCSelfAwareSwizzleSelectorHandler,
         contextRef,
+        &ObjCSelfAwareSwizzleCompletionHandler,
         &ObjCSelfAwareSwizzleContextCleanupHandler,
         -100
     );
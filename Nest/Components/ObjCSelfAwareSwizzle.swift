@@ -201,6 +201,231 @@ final public class ObjCSelfAwareSwizzle: NSObject {
         return succeeded
     }
     
+    /// Performs `swizzles` in a batch grouped by target class.
+    ///
+    /// - Discussion: All the swizzles are validated before any class gets
+    /// modified, thus a failure leaves every class untouched. Duplicate
+    /// swizzles are performed only once. Superclasses get swizzled before
+    /// their subclasses, so that a swizzle on a subclass calls through to
+    /// the swizzled implementation of its superclass.
+    @objc(performSwizzles:performedCount:error:)
+    public static func perform(
+        _ swizzles: [ObjCSelfAwareSwizzle],
+        performedCount: UnsafeMutablePointer<Int>?,
+        error: NSErrorPointer
+        )
+        -> Bool
+    {
+        error?.pointee = nil
+        performedCount?.pointee = 0
+        
+        // Deduplicate and group by target class.
+        var uniqueSwizzles = Set<ObjCSelfAwareSwizzle>()
+        var groups = [[ObjCSelfAwareSwizzle]]()
+        var groupIndices = [ObjectIdentifier: Int]()
+        
+        for eachSwizzle in swizzles where !uniqueSwizzles.contains(eachSwizzle) {
+            uniqueSwizzles.insert(eachSwizzle)
+            let key = ObjectIdentifier(eachSwizzle.targetClass)
+            if let index = groupIndices[key] {
+                groups[index].append(eachSwizzle)
+            } else {
+                groupIndices[key] = groups.count
+                groups.append([eachSwizzle])
+            }
+        }
+        
+        // Superclasses first, then in the order of appearance.
+        let orderedGroups = groups.enumerated().map {
+            (depth: _classDepth($1[0].targetClass), index: $0, swizzles: $1)
+            }.sorted {
+                ($0.depth, $0.index) < ($1.depth, $1.index)
+            }.map { $0.swizzles }
+        
+        // Validate
+        var operations = [[_BatchOperation]]()
+        operations.reserveCapacity(orderedGroups.count)
+        
+        for eachGroup in orderedGroups {
+            var groupOperations = [_BatchOperation]()
+            groupOperations.reserveCapacity(eachGroup.count)
+            
+            for eachSwizzle in eachGroup {
+                do {
+                    groupOperations.append(try eachSwizzle._batchOperation())
+                } catch let validationError as NSError {
+                    error?.pointee = validationError
+                    return false
+                }
+            }
+            
+            operations.append(groupOperations)
+        }
+        
+        // Apply
+        for eachGroup in operations {
+            var replacedSelectors = Set<Selector>()
+            
+            for eachOperation in eachGroup {
+                switch eachOperation {
+                case let .replace(
+                    targetClass,
+                    targetSelector,
+                    targetMethod,
+                    encoding,
+                    originalImplPtr,
+                    swizzledImpl
+                    ):
+                    
+                    // `class_replaceMethod` returns nil when the method was
+                    // inherited and got added to `targetClass`.
+                    let replacedImpl: IMP? = class_replaceMethod(
+                        targetClass, targetSelector, swizzledImpl, encoding
+                    )
+                    
+                    originalImplPtr.pointee = replacedImpl
+                        ?? method_getImplementation(targetMethod)
+                    
+                    replacedSelectors.insert(targetSelector)
+                    
+                case let .exchange(
+                    targetClass,
+                    originalSelector,
+                    swizzledSelector,
+                    originalMethod,
+                    swizzledMethod
+                    ):
+                    
+                    // Methods may have been added to `targetClass` by a
+                    // previous replacement in this batch.
+                    if replacedSelectors.contains(originalSelector)
+                        || replacedSelectors.contains(swizzledSelector)
+                    {
+                        method_exchangeImplementations(
+                            class_getInstanceMethod(
+                                targetClass, originalSelector
+                            ),
+                            class_getInstanceMethod(
+                                targetClass, swizzledSelector
+                            )
+                        )
+                    } else {
+                        method_exchangeImplementations(
+                            originalMethod, swizzledMethod
+                        )
+                    }
+                }
+            }
+        }
+        
+        performedCount?.pointee = uniqueSwizzles.count
+        
+        return true
+    }
+    
+    private enum _BatchOperation {
+        case replace(
+            class: AnyClass,
+            selector: Selector,
+            method: Method,
+            encoding: UnsafePointer<Int8>,
+            originalImplPointer: UnsafeMutablePointer<IMP>,
+            swizzledImpl: IMP
+        )
+        
+        case exchange(
+            class: AnyClass,
+            originalSelector: Selector,
+            swizzledSelector: Selector,
+            originalMethod: Method,
+            swizzledMethod: Method
+        )
+    }
+    
+    /// Validates the swizzle without modifying the target class.
+    private func _batchOperation() throws -> _BatchOperation {
+        switch implSource {
+        case let .impl(
+            targetClass,
+            targetSelector,
+            originalImplPtr,
+            swizzledImpl
+            ):
+            
+            guard let targetMethod = class_getInstanceMethod(
+                targetClass,
+                targetSelector
+                ) else
+            {
+                throw _error("The target class(\(targetClass)) or its superclasses do not contain an instance method with the specified selector: \(self.description(forSelector: targetSelector)).")
+            }
+            
+            guard let encoding = method_getTypeEncoding(targetMethod) else {
+                throw _error("Not type encoding for target method of selector: \(self.description(forSelector: targetSelector)).")
+            }
+            
+            return .replace(
+                class: targetClass,
+                selector: targetSelector,
+                method: targetMethod,
+                encoding: encoding,
+                originalImplPointer: originalImplPtr,
+                swizzledImpl: swizzledImpl
+            )
+            
+        case let .selector(
+            targetClass,
+            originalSelector,
+            swizzledSelector
+            ):
+            
+            guard let originalMethod = class_getInstanceMethod(
+                targetClass,
+                originalSelector
+                ) else
+            {
+                throw _error("The target class(\(targetClass)) or its superclasses do not contain an instance method with the specified selector: \(self.description(forSelector: originalSelector)).")
+            }
+            
+            guard let swizzledMethod = class_getInstanceMethod(
+                targetClass,
+                swizzledSelector
+                ) else
+            {
+                throw _error("The target class(\(targetClass)) or its superclasses do not contain an instance method with the specified selector: \(self.description(forSelector: swizzledSelector)).")
+            }
+            
+            return .exchange(
+                class: targetClass,
+                originalSelector: originalSelector,
+                swizzledSelector: swizzledSelector,
+                originalMethod: originalMethod,
+                swizzledMethod: swizzledMethod
+            )
+        }
+    }
+    
+    /// Makes an error which names the offending swizzle.
+    private func _error(_ description: String) -> NSError {
+        return NSError(
+            domain: "com.WeZZard.Nest.ObjCSelfAwareSwizzle",
+            code: -2,
+            userInfo: [
+                NSLocalizedDescriptionKey : "\(self.description): \(description)"
+            ]
+        )
+    }
+    
+    private static func _classDepth(_ aClass: AnyClass) -> Int {
+        var depth = 0
+        var superclass: AnyClass? = class_getSuperclass(aClass)
+        while let eachSuperclass = superclass {
+            depth += 1
+            superclass = class_getSuperclass(eachSuperclass)
+        }
+        return depth
+    }
+    
     private func description(forSelector selector: Selector) -> String {
         if isMetaClass {
             return "+\(selector)]"
@@ -224,6 +449,11 @@ final public class ObjCSelfAwareSwizzle: NSObject {
         return prefix + contextInfo + ">"
     }
     
+    public override var hash: Int {
+        return ObjectIdentifier(targetClass).hashValue
+            ^ targetSelector.hashValue
+    }
+    
     public override func isEqual(_ object: Any?) -> Bool {
         if let compared = object as? ObjCSelfAwareSwizzle {
             return targetClass === compared.targetClass
@@ -0,0 +1,194 @@
+//
+//  PersistentController+ManagedObjectChangeSet.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import CoreData
+
+extension PersistentController {
+    /// A view of the changes carried by a managed object context
+    /// notification. Nothing is copied until a set is accessed.
+    public struct ManagedObjectChangeSet: Sequence {
+        public typealias Element = (
+            key: NSManagedObjectChangeKey,
+            value: Set<NSManagedObject>
+        )
+        
+        public typealias Iterator = AnyIterator<Element>
+        
+        private let _userInfo: [AnyHashable : Any]
+        
+        /// Changes carried as object IDs, whose managed objects are faulted
+        /// in `_context` only when accessed.
+        private let _objectIDs: [NSManagedObjectChangeKey: [NSManagedObjectID]]
+        
+        private let _context: NSManagedObjectContext?
+        
+        internal init(userInfo: [AnyHashable : Any]?) {
+            _userInfo = userInfo ?? [:]
+            _objectIDs = [:]
+            _context = nil
+        }
+        
+        internal init(_ changes: ManagedObjectChanges) {
+            self.init(changes, objectIDs: [:], context: nil)
+        }
+        
+        /// Managed objects of `objectIDs` are faulted in `context` on
+        /// access, which shall be on the queue of `context`.
+        internal init(
+            _ changes: ManagedObjectChanges,
+            objectIDs: [NSManagedObjectChangeKey: [NSManagedObjectID]],
+            context: NSManagedObjectContext?
+            )
+        {
+            var userInfo = [AnyHashable : Any]()
+            for (key, objects) in changes {
+                userInfo[AnyHashable(key.rawValue)] = objects as NSSet
+            }
+            _userInfo = userInfo
+            _objectIDs = objectIDs
+            _context = context
+        }
+        
+        /// Keys of the changes which carry managed objects.
+        public var keys: [NSManagedObjectChangeKey] {
+            var keys: [NSManagedObjectChangeKey] = _userInfo.flatMap {
+                (key, value) in
+                value is NSSet
+                    ? NSManagedObjectChangeKey(rawValue: key.base as! String)
+                    : nil
+            }
+            for key in _objectIDs.keys where !keys.contains(key) {
+                keys.append(key)
+            }
+            return keys
+        }
+        
+        public var isEmpty: Bool {
+            return !_userInfo.values.contains { ($0 as? NSSet)?.count ?? 0 > 0 }
+                && !_objectIDs.values.contains { !$0.isEmpty }
+        }
+        
+        /// Materializes the set of managed objects for `key`.
+        public subscript(key: NSManagedObjectChangeKey)
+            -> Set<NSManagedObject>?
+        {
+            return _objects(for: key).map { $0 as! Set<NSManagedObject> }
+        }
+        
+        public func count(for key: NSManagedObjectChangeKey) -> Int {
+            if let objectIDs = _objectIDs[key] {
+                return objectIDs.count
+            }
+            return _objects(for: key)?.count ?? 0
+        }
+        
+        /// Returns object IDs of the managed objects for `key` without
+        /// materializing the set of managed objects.
+        public func objectIDs(for key: NSManagedObjectChangeKey)
+            -> [NSManagedObjectID]
+        {
+            if let objectIDs = _objectIDs[key] {
+                return objectIDs
+            }
+            
+            guard let objects = _objects(for: key) else { return [] }
+            
+            var objectIDs = [NSManagedObjectID]()
+            objectIDs.reserveCapacity(objects.count)
+            for each in objects {
+                objectIDs.append((each as! NSManagedObject).objectID)
+            }
+            return objectIDs
+        }
+        
+        /// Returns object IDs of all the changes without materializing the
+        /// sets of managed objects.
+        public var objectIDs: [NSManagedObjectChangeKey: [NSManagedObjectID]] {
+            var objectIDs = [NSManagedObjectChangeKey: [NSManagedObjectID]]()
+            for key in keys {
+                objectIDs[key] = self.objectIDs(for: key)
+            }
+            return objectIDs
+        }
+        
+        /// Materializes all the changes.
+        public var managedObjectChanges: ManagedObjectChanges {
+            var changes = ManagedObjectChanges()
+            for (key, objects) in self {
+                changes[key] = objects
+            }
+            return changes
+        }
+        
+        public func makeIterator() -> Iterator {
+            var keysIterator = keys.makeIterator()
+            return AnyIterator {
+                guard let key = keysIterator.next() else { return nil }
+                return (key, self[key]!)
+            }
+        }
+        
+        /// Entities of all the changed objects.
+        internal var entities: [NSEntityDescription] {
+            var entities = [NSEntityDescription]()
+            var visitedEntities = Set<ObjectIdentifier>()
+            for case let objects as NSSet in _userInfo.values {
+                for case let object as NSManagedObject in objects
+                    where visitedEntities
+                        .insert(ObjectIdentifier(object.entity)).inserted
+                {
+                    entities.append(object.entity)
+                }
+            }
+            for objectIDs in _objectIDs.values {
+                for each in objectIDs
+                    where visitedEntities
+                        .insert(ObjectIdentifier(each.entity)).inserted
+                {
+                    entities.append(each.entity)
+                }
+            }
+            return entities
+        }
+        
+        private func _objects(for key: NSManagedObjectChangeKey) -> NSSet? {
+            if let objects = _userInfo[AnyHashable(key.rawValue)] as? NSSet {
+                return objects
+            }
+            
+            guard let objectIDs = _objectIDs[key], let context = _context else {
+                return nil
+            }
+            
+            return NSSet(array: objectIDs.map { context.object(with: $0) })
+        }
+    }
+    
+    /// Events of the fetching context and the saving context, whose hooks
+    /// are called.
+    public struct ContextEvents: OptionSet {
+        public let rawValue: Int
+        
+        public init(rawValue: Int) {
+            self.rawValue = rawValue
+        }
+        
+        /// `context(_:objectsDidChange:)`
+        public static let objectsDidChange = ContextEvents(rawValue: 1 << 0)
+        
+        /// `context(_:willSave:)`
+        public static let willSave = ContextEvents(rawValue: 1 << 1)
+        
+        /// `context(_:didSave:)`
+        public static let didSave = ContextEvents(rawValue: 1 << 2)
+        
+        public static let all: ContextEvents = [
+            .objectsDidChange, .willSave, .didSave
+        ]
+    }
+}
@@ -11,11 +11,19 @@ import CoreData
 
 @available(iOS 3.0, *)
 open class PersistentController {
+    /// Loads the persistent store asynchronously. Transactions submitted
+    /// before the store was loaded wait for it.
+    ///
+    /// - Parameter warmUpEntityNames: Names of entities whose objects are
+    /// fetched in the background once the store was loaded, up to
+    /// `PersistentController.warmUpFetchLimit` objects per entity, which
+    /// loads their pages into the page cache of the SQLite store.
     public init(
         store: PersistentStore,
         modelBundle: Bundle,
         modelName: String,
-        modelExtension: String = "momd"
+        modelExtension: String = "momd",
+        warmUpEntityNames: [String] = []
         )
     {
         _fetchingContext = NSManagedObjectContext(
@@ -54,6 +62,10 @@ open class PersistentController {
         
         _managedObjectModel = managedObjectModel
         
+        _fetchRequestTemplateCache = _FetchRequestTemplateCache(
+            managedObjectModel: managedObjectModel
+        )
+        
         let persistentStoreCoordinator = NSPersistentStoreCoordinator(
             managedObjectModel: managedObjectModel
         )
@@ -62,10 +74,29 @@ open class PersistentController {
         
         _fetchingContext.parent = _savingContext
         
-        _operationQueue.async {
+        // Captured without blocking, since `performAndWait` might run on
+        // the calling thread. Blocks performed later on the saving context
+        // run after this one, thus see the label once they read it on
+        // `_saveQueue`.
+        let saveQueue = _saveQueue
+        _savingContext.perform { [weak self] in
+            let savingContextQueueLabel = DispatchQueue.currentQueueLabel
+            saveQueue.async {
+                self?._savingContextQueueLabel = savingContextQueueLabel
+            }
+        }
+        
+        let persistentStoreLoadingGroup = _persistentStoreLoadingGroup
+        let storeLoadingProgress = self.storeLoadingProgress
+        
+        persistentStoreLoadingGroup.enter()
+        
+        _operationQueue.async { [weak self] in
             let (persistentStoreType, persistentStoreURL)
                 = store._toPrimitives()
             
+            var errorOrNil: Error?
+            
             if let url = persistentStoreURL {
                 do {
                     let containingDir = url.deletingLastPathComponent()
@@ -77,24 +108,62 @@ open class PersistentController {
                     )
                     
                 } catch let error {
-                    fatalError("Cannot create persistent store's containing directory: \(error)")
+                    errorOrNil = error
                 }
             }
             
-            do {
-                try persistentStoreCoordinator.addPersistentStore(
-                    ofType: persistentStoreType,
-                    configurationName: nil,
-                    at: persistentStoreURL,
-                    options: NSPersistentStoreCoordinator._options(
-                        for: store
+            storeLoadingProgress.completedUnitCount += 1
+            
+            if errorOrNil == nil {
+                do {
+                    // Lightweight migration happens here and reports no
+                    // progress itself.
+                    try persistentStoreCoordinator.addPersistentStore(
+                        ofType: persistentStoreType,
+                        configurationName: nil,
+                        at: persistentStoreURL,
+                        options: NSPersistentStoreCoordinator._options(
+                            for: store
+                        )
                     )
-                )
-            } catch let error {
-                fatalError("Cannot migrate persistent store: \(error)")
+                } catch let error {
+                    errorOrNil = error
+                }
+            }
+            
+            storeLoadingProgress.completedUnitCount += 1
+            
+            if let error = errorOrNil {
+                #if DEBUG
+                    NSLog("PersistentController: Cannot load persistent store: \(error)")
+                #endif
+                self?._setStoreLoadingState(.failed(error))
+                storeLoadingProgress.completedUnitCount
+                    = storeLoadingProgress.totalUnitCount
+                persistentStoreLoadingGroup.leave()
+                return
             }
+            
+            self?._setStoreLoadingState(.loaded)
+            persistentStoreLoadingGroup.leave()
+            
+            PersistentController._warmUp(
+                entityNames: warmUpEntityNames,
+                persistentStoreCoordinator: persistentStoreCoordinator,
+                progress: storeLoadingProgress
+            )
         }
         
+        let observedContextEvents = self.observedContextEvents
+        
+        _observesObjectsDidChange
+            = observedContextEvents.contains(.objectsDidChange)
+        _observesWillSave = observedContextEvents.contains(.willSave)
+        _observesDidSave = observedContextEvents.contains(.didSave)
+        
+        // Objects-did-change notifications are always observed to keep
+        // cached fetch results up to date with changes merged into the
+        // contexts.
         NotificationCenter.default.addObserver(
             self,
             selector:
@@ -102,29 +171,33 @@ open class PersistentController {
             name: .NSManagedObjectContextObjectsDidChange,
             object: _fetchingContext
         )
-        NotificationCenter.default.addObserver(
-            self,
-            selector: #selector(_handleFetchingContext(willSave:)),
-            name: .NSManagedObjectContextWillSave,
-            object: _fetchingContext
-        )
-        NotificationCenter.default.addObserver(
-            self,
-            selector: #selector(_handleFetchingContext(didSave:)),
-            name: .NSManagedObjectContextDidSave,
-            object: _fetchingContext
-        )
         NotificationCenter.default.addObserver(
             self,
             selector: #selector(_handleSavingContextObjects(didChange:)),
             name: .NSManagedObjectContextObjectsDidChange,
             object: _savingContext
         )
+        if _observesWillSave {
+            NotificationCenter.default.addObserver(
+                self,
+                selector: #selector(_handleFetchingContext(willSave:)),
+                name: .NSManagedObjectContextWillSave,
+                object: _fetchingContext
+            )
+            NotificationCenter.default.addObserver(
+                self,
+                selector: #selector(_handleSavingContext(willSave:)),
+                name: .NSManagedObjectContextWillSave,
+                object: _savingContext
+            )
+        }
+        // Did-save notifications are always observed to keep read contexts
+        // and cached fetch results up to date.
         NotificationCenter.default.addObserver(
             self,
-            selector: #selector(_handleSavingContext(willSave:)),
-            name: .NSManagedObjectContextWillSave,
-            object: _savingContext
+            selector: #selector(_handleFetchingContext(didSave:)),
+            name: .NSManagedObjectContextDidSave,
+            object: _fetchingContext
         )
         NotificationCenter.default.addObserver(
             self,
@@ -167,17 +240,31 @@ open class PersistentController {
         )
     }
     
+    /// Saves the fetching context and then the saving context. The
+    /// completion handler is called when the changes are durable.
+    ///
+    /// - Notes: With `.coalescing` save mode, the saving is deferred and
+    /// merged with other savings, and this method never blocks.
     public func save(
         with completionHandler: ((_ error: Error?) -> Void)? = nil
         )
     {
+        if case let .coalescing(window, changeCountThreshold) = saveMode {
+            _enqueueCoalescedSave(
+                window: window,
+                changeCountThreshold: changeCountThreshold,
+                completionHandler: completionHandler
+            )
+            return
+        }
+        
         performAndWait { (ctx) in
             var errorOrNil: Error?
             
             self._fetchingContext.performAndWait {
                 if self._fetchingContext.hasChanges {
                     do {
-                        try self._fetchingContext.save()
+                        try self._save(self._fetchingContext)
                     } catch let error {
                         errorOrNil = error
                     }
@@ -190,7 +277,7 @@ open class PersistentController {
                 self._savingContext.perform { _ in
                     if self._savingContext.hasChanges {
                         do {
-                            try self._savingContext.save()
+                            try self._save(self._savingContext)
                             completionHandler?(nil)
                         } catch let error {
                             errorOrNil = error
@@ -204,14 +291,207 @@ open class PersistentController {
         }
     }
     
+    /// Saves all the pending changes synchronously, including those
+    /// deferred by `.coalescing` save mode, and calls their completion
+    /// handlers. Call this when the app is about to be suspended.
+    ///
+    /// - Notes: Must not be called on the saving context's queue, such as
+    /// from a save completion handler or `context(_:didSave:)` of the
+    /// saving context, where waiting for the fetching context deadlocks.
+    /// Such a call asserts and returns without saving.
+    public func flush() {
+        let currentQueueLabel = DispatchQueue.currentQueueLabel
+        
+        let isOnSavingContextQueue = _saveQueue.sync {
+            currentQueueLabel == _savingContextQueueLabel
+        }
+        
+        guard !isOnSavingContextQueue else {
+            assertionFailure("PersistentController.flush() is called on the saving context's queue, which deadlocks.")
+            return
+        }
+        
+        let completionHandlers = _saveQueue.sync {
+            () -> [(Error?) -> Void] in
+            let completionHandlers = _pendingSaveCompletionHandlers
+            _pendingSaveCompletionHandlers = []
+            _pendingSaveCount = 0
+            _saveFlushGeneration += 1
+            return completionHandlers
+        }
+        
+        var errorOrNil: Error? = performAndWait { (ctx) -> Error? in
+            if ctx.hasChanges {
+                do {
+                    try self._save(ctx)
+                } catch let error {
+                    return error
+                }
+            }
+            return nil
+        }
+        
+        if errorOrNil == nil {
+            _savingContext.performAndWait {
+                if self._savingContext.hasChanges {
+                    do {
+                        try self._save(self._savingContext)
+                    } catch let error {
+                        errorOrNil = error
+                    }
+                }
+            }
+        }
+        
+        completionHandlers.forEach { $0(errorOrNil) }
+    }
+    
+    private func _enqueueCoalescedSave(
+        window: TimeInterval,
+        changeCountThreshold: Int,
+        completionHandler: ((_ error: Error?) -> Void)?
+        )
+    {
+        perform { (context) in
+            let changeCount = context.insertedObjects.count
+                + context.updatedObjects.count
+                + context.deletedObjects.count
+            
+            self._saveQueue.async {
+                if let completionHandler = completionHandler {
+                    self._pendingSaveCompletionHandlers.append(
+                        completionHandler
+                    )
+                }
+                
+                self._pendingSaveCount += 1
+                
+                if changeCount >= changeCountThreshold {
+                    self._flushCoalescedSaves()
+                } else if self._pendingSaveCount == 1 {
+                    let generation = self._saveFlushGeneration
+                    self._saveQueue.asyncAfter(deadline: .now() + window) {
+                        if generation == self._saveFlushGeneration {
+                            self._flushCoalescedSaves()
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    /// Saves the fetching context and then the saving context in the
+    /// background. Always called on `_saveQueue`.
+    private func _flushCoalescedSaves() {
+        let completionHandlers = _pendingSaveCompletionHandlers
+        _pendingSaveCompletionHandlers = []
+        _pendingSaveCount = 0
+        _saveFlushGeneration += 1
+        
+        perform { (ctx) in
+            var errorOrNil: Error?
+            
+            if ctx.hasChanges {
+                do {
+                    try self._save(ctx)
+                } catch let error {
+                    errorOrNil = error
+                }
+            }
+            
+            if errorOrNil != nil {
+                completionHandlers.forEach { $0(errorOrNil) }
+                return
+            }
+            
+            self._savingContext.perform {
+                if self._savingContext.hasChanges {
+                    do {
+                        try self._save(self._savingContext)
+                    } catch let error {
+                        errorOrNil = error
+                    }
+                }
+                
+                completionHandlers.forEach { $0(errorOrNil) }
+            }
+        }
+    }
+    
+    /// Saves `context` and records the saving in `metrics`. Contexts other
+    /// than the saving context and the fetching context are recorded as
+    /// batch savings.
+    private func _save(_ context: NSManagedObjectContext) throws {
+        let role: PersistentControllerMetrics.ContextRole
+        if context === _savingContext {
+            role = .saving
+        } else if context === _fetchingContext {
+            role = .fetching
+        } else {
+            role = .batch
+        }
+        
+        try _save(role) { (isRecorded) in
+            let changeCounts = isRecorded
+                ? (
+                    inserted: context.insertedObjects.count,
+                    updated: context.updatedObjects.count,
+                    deleted: context.deletedObjects.count
+                )
+                : (inserted: 0, updated: 0, deleted: 0)
+            
+            try context.save()
+            
+            return changeCounts
+        }
+    }
+    
+    /// Calls `save`, which writes changes to the persistent store and
+    /// returns the counts of changed objects, and records it in `metrics`.
+    /// `save` receives whether it is recorded, which it shall not count
+    /// changed objects for when not.
+    private func _save(
+        _ role: PersistentControllerMetrics.ContextRole,
+        _ save: (_ isRecorded: Bool) throws -> _ChangeCounts
+        ) throws
+    {
+        let isRecorded = metrics.isEnabled
+        
+        let started = PersistentControllerMetrics.now()
+        
+        let changeCounts = try save(isRecorded)
+        
+        guard isRecorded else { return }
+        
+        metrics.recordSave(
+            role,
+            started: started,
+            finished: PersistentControllerMetrics.now(),
+            insertedObjectCount: changeCounts.inserted,
+            updatedObjectCount: changeCounts.updated,
+            deletedObjectCount: changeCounts.deleted
+        )
+    }
+    
+    private typealias _ChangeCounts = (inserted: Int, updated: Int, deleted: Int)
+    
     public func perform(
         _ transaction: @escaping (NSManagedObjectContext) -> Void
         )
     {
         let context = _fetchingContext
+        let metrics = self.metrics
+        let enqueued = PersistentControllerMetrics.now()
         _operationQueue.async {
             context.perform {
+                let started = PersistentControllerMetrics.now()
                 transaction(context)
+                metrics.recordTransaction(
+                    .perform,
+                    enqueued: enqueued,
+                    started: started,
+                    finished: PersistentControllerMetrics.now()
+                )
             }
         }
     }
@@ -222,32 +502,537 @@ open class PersistentController {
     {
         var returnValue: R!
         
+        var started: UInt64 = 0
+        let enqueued = PersistentControllerMetrics.now()
+        
         let currentQueueLabel = DispatchQueue.currentQueueLabel
         
         if currentQueueLabel == _operationQueue.label {
             _fetchingContext.performAndWait {
+                started = PersistentControllerMetrics.now()
                 returnValue = transaction(self._fetchingContext)
             }
         } else {
             _operationQueue.sync {
                 _fetchingContext.performAndWait {
+                    started = PersistentControllerMetrics.now()
                     returnValue = transaction(self._fetchingContext)
                 }
             }
         }
         
+        metrics.recordTransaction(
+            .performAndWait,
+            enqueued: enqueued,
+            started: started,
+            finished: PersistentControllerMetrics.now()
+        )
+        
+        return returnValue
+        
+    }
+    
+    // MARK: Batch Operations
+    /// Inserts objects of `entityName` with property values in `objects`
+    /// into the persistent store, in chunks of `chunkSize` objects on a
+    /// private queue context attached to the persistent store coordinator.
+    ///
+    /// - Notes: This is not a store-level batch request. Objects are
+    /// created as managed objects and saved chunk by chunk, which bypasses
+    /// the saving context but still validates the objects.
+    ///
+    /// - Notes: Chunks are not rolled back. When saving a chunk fails, the
+    /// chunks saved before it stay in the store, and the completion handler
+    /// receives their object IDs along with the error.
+    ///
+    /// - Notes: Inserted object IDs are merged into the saving context, the
+    /// fetching context and the read contexts, and `context(_:didSave:)` is
+    /// called for the saving context and the fetching context. The
+    /// completion handler is called on the saving context's queue.
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    public func batchInsert(
+        entityName: String,
+        objects: [[String: Any]],
+        chunkSize: Int = 1024,
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)? = nil
+        )
+    {
+        let chunkSize = max(chunkSize, 1)
+        
+        _operationQueue.async {
+            let context = NSManagedObjectContext(
+                concurrencyType: .privateQueueConcurrencyType
+            )
+            context.persistentStoreCoordinator
+                = self._savingContext.persistentStoreCoordinator
+            context.undoManager = nil
+            
+            context.perform {
+                var objectIDs = [NSManagedObjectID]()
+                objectIDs.reserveCapacity(objects.count)
+                
+                var errorOrNil: Error?
+                
+                var chunkStart = 0
+                
+                while chunkStart < objects.count {
+                    let chunkEnd = min(chunkStart + chunkSize, objects.count)
+                    
+                    let insertedObjects = objects[chunkStart..<chunkEnd].map {
+                        (values) -> NSManagedObject in
+                        let object = NSEntityDescription.insertNewObject(
+                            forEntityName: entityName, into: context
+                        )
+                        object.setValuesForKeys(values)
+                        return object
+                    }
+                    
+                    do {
+                        try self._save(context)
+                    } catch let error {
+                        errorOrNil = error
+                        break
+                    }
+                    
+                    objectIDs.append(contentsOf: insertedObjects.map {
+                        $0.objectID
+                    })
+                    
+                    // Keeps the memory usage bounded by the chunk size.
+                    context.reset()
+                    
+                    chunkStart = chunkEnd
+                }
+                
+                self._mergeBatchChanges(
+                    [NSInsertedObjectsKey: objectIDs]
+                ) {
+                    completionHandler?(objectIDs, errorOrNil)
+                }
+            }
+        }
+    }
+    
+    /// Updates properties of objects of `entityName` matching `predicate`
+    /// with a batch update request executed against the persistent store.
+    ///
+    /// - Notes: Object IDs are merged into the saving context, the
+    /// fetching context and the read contexts, and `context(_:didSave:)` is
+    /// called for the saving context and the fetching context. The
+    /// completion handler is called on the saving context's queue.
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    public func batchUpdate(
+        entityName: String,
+        predicate: NSPredicate? = nil,
+        propertiesToUpdate: [AnyHashable : Any],
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)? = nil
+        )
+    {
+        let request = NSBatchUpdateRequest(entityName: entityName)
+        request.predicate = predicate
+        request.propertiesToUpdate = propertiesToUpdate
+        request.resultType = .updatedObjectIDsResultType
+        
+        _executeBatchRequest(
+            request, changeKey: NSUpdatedObjectsKey,
+            completionHandler: completionHandler
+        )
+    }
+    
+    /// Deletes objects of `entityName` matching `predicate` with a batch
+    /// delete request executed against the persistent store.
+    ///
+    /// - Notes: Object IDs are merged into the saving context, the
+    /// fetching context and the read contexts, and `context(_:didSave:)` is
+    /// called for the saving context and the fetching context. The
+    /// completion handler is called on the saving context's queue.
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    public func batchDelete(
+        entityName: String,
+        predicate: NSPredicate? = nil,
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)? = nil
+        )
+    {
+        let fetchRequest = NSFetchRequest<NSFetchRequestResult>(
+            entityName: entityName
+        )
+        fetchRequest.predicate = predicate
+        
+        let request = NSBatchDeleteRequest(fetchRequest: fetchRequest)
+        request.resultType = .resultTypeObjectIDs
+        
+        _executeBatchRequest(
+            request, changeKey: NSDeletedObjectsKey,
+            completionHandler: completionHandler
+        )
+    }
+    
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    private func _executeBatchRequest(
+        _ request: NSPersistentStoreRequest,
+        changeKey: String,
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)?
+        )
+    {
+        _operationQueue.async {
+            self._savingContext.perform {
+                var objectIDs = [NSManagedObjectID]()
+                
+                do {
+                    try self._save(.batch) { _ in
+                        let result = try self._savingContext.execute(request)
+                        
+                        switch result {
+                        case let result as NSBatchUpdateResult:
+                            objectIDs = result.result as? [NSManagedObjectID] ?? []
+                        case let result as NSBatchDeleteResult:
+                            objectIDs = result.result as? [NSManagedObjectID] ?? []
+                        default:
+                            break
+                        }
+                        
+                        return (
+                            inserted: 0,
+                            updated: changeKey == NSUpdatedObjectsKey
+                                ? objectIDs.count : 0,
+                            deleted: changeKey == NSDeletedObjectsKey
+                                ? objectIDs.count : 0
+                        )
+                    }
+                } catch let error {
+                    completionHandler?([], error)
+                    return
+                }
+                
+                self._mergeBatchChanges([changeKey: objectIDs]) {
+                    completionHandler?(objectIDs, nil)
+                }
+            }
+        }
+    }
+    
+    /// Merges changes made directly in the persistent store into the read
+    /// contexts, the saving context and then the fetching context, and
+    /// calls `context(_:didSave:)` for the latter two as if they saved the
+    /// changes, with inserted and updated objects faulted only when
+    /// accessed. Calls `completion` on the saving context's queue.
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    private func _mergeBatchChanges(
+        _ changes: [String: [NSManagedObjectID]],
+        completion: @escaping () -> Void
+        )
+    {
+        let observesDidSave = _observesDidSave
+        
+        func merge(into context: NSManagedObjectContext)
+            -> ManagedObjectChangeSet
+        {
+            var managedObjectChanges = ManagedObjectChanges()
+            
+            guard observesDidSave else {
+                NSManagedObjectContext.mergeChanges(
+                    fromRemoteContextSave: changes as [AnyHashable : Any],
+                    into: [context]
+                )
+                return ManagedObjectChangeSet(managedObjectChanges)
+            }
+            
+            // Deleted objects are gone after merging.
+            if let deleted = changes[NSDeletedObjectsKey] {
+                managedObjectChanges[.deleted] = Set(
+                    deleted.flatMap { context.registeredObject(for: $0) }
+                )
+            }
+            
+            NSManagedObjectContext.mergeChanges(
+                fromRemoteContextSave: changes as [AnyHashable : Any],
+                into: [context]
+            )
+            
+            // Faulting every inserted or updated object here would cost as
+            // much as not using a batch request, so they are faulted only
+            // when accessed.
+            var objectIDs = [NSManagedObjectChangeKey: [NSManagedObjectID]]()
+            for (key, each) in changes where key != NSDeletedObjectsKey {
+                objectIDs[NSManagedObjectChangeKey(rawValue: key)] = each
+            }
+            
+            return ManagedObjectChangeSet(
+                managedObjectChanges, objectIDs: objectIDs, context: context
+            )
+        }
+        
+        let readContexts = _readContextPoolQueue.sync {
+            _readContextPool.map { $0.context }
+        }
+        if !readContexts.isEmpty {
+            NSManagedObjectContext.mergeChanges(
+                fromRemoteContextSave: changes as [AnyHashable : Any],
+                into: readContexts
+            )
+        }
+        
+        _savingContext.perform {
+            self._fetchRequestTemplateCache.invalidateObjectIDs(
+                for: changes.values.joined().map { $0.entity }
+            )
+            
+            let savingContextChanges = merge(into: self._savingContext)
+            
+            if observesDidSave {
+                self.context(
+                    .forSaving(self._savingContext),
+                    didSave: savingContextChanges
+                )
+            }
+            
+            self._fetchingContext.perform {
+                let fetchingContextChanges = merge(into: self._fetchingContext)
+                
+                if observesDidSave {
+                    self.context(
+                        .forFetching(self._fetchingContext),
+                        didSave: fetchingContextChanges
+                    )
+                }
+                
+                self._savingContext.perform(completion)
+            }
+        }
+    }
+    
+    // MARK: Store Loading
+    /// The state of persistent store loading.
+    public var storeLoadingState: StoreLoadingState {
+        return _readContextPoolQueue.sync { _storeLoadingState }
+    }
+    
+    /// Progress of store loading, made of preparing the store's directory,
+    /// adding the store which includes the lightweight migration, and the
+    /// warm-up.
+    public let storeLoadingProgress: Progress = {
+        // Not attached to the current progress.
+        let progress = Progress(parent: nil, userInfo: nil)
+        progress.totalUnitCount = 3
+        return progress
+    }()
+    
+    /// Calls `handler` on `queue` once the persistent store was loaded or
+    /// failed to load. The warm-up is not waited.
+    public func whenStoreLoaded(
+        on queue: DispatchQueue = .main,
+        _ handler: @escaping (_ error: Error?) -> Void
+        )
+    {
+        _persistentStoreLoadingGroup.notify(queue: queue) {
+            if case let .failed(error) = self.storeLoadingState {
+                handler(error)
+            } else {
+                handler(nil)
+            }
+        }
+    }
+    
+    private func _setStoreLoadingState(_ state: StoreLoadingState) {
+        _readContextPoolQueue.sync { _storeLoadingState = state }
+    }
+    
+    /// The maximum count of objects fetched per entity by the warm-up.
+    public static let warmUpFetchLimit = 1024
+    
+    /// Fetches objects of `entityNames` as non-faults on a private queue
+    /// context, and then throws the objects away.
+    ///
+    /// - Notes: Only the page cache of the SQLite store stays warm. The row
+    /// cache of the persistent store coordinator releases the snapshots
+    /// along with the objects when the context is reset.
+    private static func _warmUp(
+        entityNames: [String],
+        persistentStoreCoordinator: NSPersistentStoreCoordinator,
+        progress: Progress
+        )
+    {
+        guard !entityNames.isEmpty else {
+            progress.completedUnitCount = progress.totalUnitCount
+            return
+        }
+        
+        let context = NSManagedObjectContext(
+            concurrencyType: .privateQueueConcurrencyType
+        )
+        context.persistentStoreCoordinator = persistentStoreCoordinator
+        context.undoManager = nil
+        
+        context.perform {
+            for each in entityNames {
+                let fetchRequest = NSFetchRequest<NSManagedObject>(
+                    entityName: each
+                )
+                fetchRequest.returnsObjectsAsFaults = false
+                fetchRequest.includesPendingChanges = false
+                fetchRequest.fetchLimit = PersistentController.warmUpFetchLimit
+                
+                do {
+                    _ = try context.fetch(fetchRequest)
+                } catch let error {
+                    #if DEBUG
+                        NSLog("PersistentController: Cannot warm up \(each): \(error)")
+                    #endif
+                }
+                
+                context.reset()
+            }
+            
+            progress.completedUnitCount = progress.totalUnitCount
+        }
+    }
+    
+    // MARK: Read Context Pool
+    /// Performs a read-only transaction on one of the read contexts, which
+    /// are private queue contexts attached directly to the persistent store
+    /// coordinator. Read transactions neither wait for `perform(_:)` and
+    /// `performAndWait(_:)` transactions nor for each other, up to
+    /// `readContextPoolSize` transactions at a time.
+    ///
+    /// - Notes: Read contexts are refreshed with the changes saved by the
+    /// saving context. Changes made in a read transaction are rolled back.
+    public func performRead(
+        _ transaction: @escaping (NSManagedObjectContext) -> Void
+        )
+    {
+        _persistentStoreLoadingGroup.notify(queue: _readContextPoolQueue) {
+            let entry = self._dequeueReadContextPoolEntryLocked()
+            let context = entry.context
+            context.perform {
+                transaction(context)
+                self._finishReadTransaction(with: entry)
+            }
+        }
+    }
+    
+    public func performReadAndWait<R>(
+        _ transaction: @escaping (NSManagedObjectContext) -> R
+        ) -> R
+    {
+        _persistentStoreLoadingGroup.wait()
+        
+        var returnValue: R!
+        
+        let entry = _dequeueReadContextPoolEntry()
+        let context = entry.context
+        context.performAndWait {
+            returnValue = transaction(context)
+            self._finishReadTransaction(with: entry)
+        }
+        
         return returnValue
+    }
+    
+    /// The maximum count of read contexts. The count of active processors
+    /// by default.
+    public var readContextPoolSize: Int {
+        get {
+            return _readContextPoolQueue.sync { _readContextPoolSize }
+        }
+        set {
+            _readContextPoolQueue.sync {
+                _readContextPoolSize = max(newValue, 1)
+                _trimReadContextPool()
+            }
+        }
+    }
+    
+    /// Returns the idle read context, or creates a new one while the pool
+    /// is not full, or returns the least busy one.
+    private func _dequeueReadContextPoolEntry() -> _ReadContextPoolEntry {
+        return _readContextPoolQueue.sync {
+            _dequeueReadContextPoolEntryLocked()
+        }
+    }
+    
+    /// Always called on `_readContextPoolQueue`.
+    private func _dequeueReadContextPoolEntryLocked() -> _ReadContextPoolEntry {
+        var dequeued: _ReadContextPoolEntry! = _readContextPool
+            .min { $0.transactionCount < $1.transactionCount }
         
+        if dequeued == nil || (dequeued.transactionCount > 0
+            && _readContextPool.count < _readContextPoolSize)
+        {
+            let context = NSManagedObjectContext(
+                concurrencyType: .privateQueueConcurrencyType
+            )
+            context.persistentStoreCoordinator
+                = _savingContext.persistentStoreCoordinator
+            context.undoManager = nil
+            dequeued = _ReadContextPoolEntry(context: context)
+            _readContextPool.append(dequeued)
+        }
+        
+        dequeued.transactionCount += 1
+        return dequeued
+    }
+    
+    private func _finishReadTransaction(with entry: _ReadContextPoolEntry) {
+        if entry.context.hasChanges {
+            assertionFailure("Read transactions shall not change objects.")
+            entry.context.rollback()
+        }
+        
+        _readContextPoolQueue.sync {
+            entry.transactionCount -= 1
+            _trimReadContextPool()
+        }
+    }
+    
+    /// Removes idle read contexts beyond the pool size. Always called on
+    /// `_readContextPoolQueue`.
+    private func _trimReadContextPool() {
+        while _readContextPool.count > _readContextPoolSize,
+            let index = _readContextPool.index(where: {
+                $0.transactionCount == 0
+            })
+        {
+            _readContextPool.remove(at: index)
+        }
     }
     
     @objc(_handleFetchingContextDidChange:)
     private func _handleFetchingContextObjects(didChange: Notification) {
         let sender = (didChange.object as? NSManagedObjectContext)
         assert(sender === _fetchingContext)
-        context(
-            .forFetching(_fetchingContext),
-            objectsDidChange: didChange._extractManagedObjectChanges()
-        )
+        
+        let changes = ManagedObjectChangeSet(userInfo: didChange.userInfo)
+        
+        _fetchRequestTemplateCache.invalidateObjectIDs(for: changes.entities)
+        
+        if _observesObjectsDidChange {
+            context(.forFetching(_fetchingContext), objectsDidChange: changes)
+        }
     }
     
     @objc(_handleFetchingContextWillSave:)
@@ -256,7 +1041,7 @@ open class PersistentController {
         assert(sender === _fetchingContext)
         context(
             .forFetching(_fetchingContext),
-            willSave: willSave._extractManagedObjectChanges()
+            willSave: ManagedObjectChangeSet(userInfo: willSave.userInfo)
         )
     }
     
@@ -264,20 +1049,28 @@ open class PersistentController {
     private func _handleFetchingContext(didSave: Notification) {
         let sender = (didSave.object as? NSManagedObjectContext)
         assert(sender === _fetchingContext)
-        context(
-            .forFetching(_fetchingContext),
-            didSave: didSave._extractManagedObjectChanges()
-        )
+        
+        let changes = ManagedObjectChangeSet(userInfo: didSave.userInfo)
+        
+        _fetchRequestTemplateCache.invalidateObjectIDs(for: changes.entities)
+        
+        if _observesDidSave {
+            context(.forFetching(_fetchingContext), didSave: changes)
+        }
     }
     
     @objc(_handleSavingContextDidChange:)
     private func _handleSavingContextObjects(didChange: Notification) {
         let sender = (didChange.object as? NSManagedObjectContext)
         assert(sender === _savingContext)
-        context(
-            .forSaving(_savingContext),
-            objectsDidChange: didChange._extractManagedObjectChanges()
-        )
+        
+        let changes = ManagedObjectChangeSet(userInfo: didChange.userInfo)
+        
+        _fetchRequestTemplateCache.invalidateObjectIDs(for: changes.entities)
+        
+        if _observesObjectsDidChange {
+            context(.forSaving(_savingContext), objectsDidChange: changes)
+        }
     }
     
     @objc(_handleSavingContextWillSave:)
@@ -286,7 +1079,7 @@ open class PersistentController {
         assert(sender === _savingContext)
         context(
             .forSaving(_savingContext),
-            willSave: willSave._extractManagedObjectChanges()
+            willSave: ManagedObjectChangeSet(userInfo: willSave.userInfo)
         )
     }
     
@@ -294,31 +1087,59 @@ open class PersistentController {
     private func _handleSavingContext(didSave: Notification) {
         let sender = (didSave.object as? NSManagedObjectContext)
         assert(sender === _savingContext)
-        context(
-            .forSaving(_savingContext),
-            didSave: didSave._extractManagedObjectChanges()
-        )
+        
+        let readContexts = _readContextPoolQueue.sync {
+            _readContextPool.map { $0.context }
+        }
+        for each in readContexts {
+            each.perform { each.mergeChanges(fromContextDidSave: didSave) }
+        }
+        
+        let changes = ManagedObjectChangeSet(userInfo: didSave.userInfo)
+        
+        _fetchRequestTemplateCache.invalidateObjectIDs(for: changes.entities)
+        
+        if _observesDidSave {
+            context(.forSaving(_savingContext), didSave: changes)
+        }
+    }
+    
+    /// Latencies of transactions and savings.
+    public let metrics = PersistentControllerMetrics()
+    
+    /// Events whose hooks are called. Read once on initialization. `.all`
+    /// by default, so that hooks overridden by existing subclasses keep
+    /// being called. Objects-did-change and did-save notifications are
+    /// always observed to keep cached fetch results up to date, so
+    /// narrowing them only skips the hook calls; narrowing `.willSave`
+    /// also skips registering its observers.
+    open var observedContextEvents: ContextEvents {
+        return .all
     }
     
+    /// Called only when `observedContextEvents` contains
+    /// `.objectsDidChange`.
     open func context(
         _ context: Context,
-        objectsDidChange changes: ManagedObjectChanges
+        objectsDidChange changes: ManagedObjectChangeSet
         )
     {
         
     }
     
+    /// Called only when `observedContextEvents` contains `.willSave`.
     open func context(
         _ context: Context,
-        willSave changes: ManagedObjectChanges
+        willSave changes: ManagedObjectChangeSet
         )
     {
         
     }
     
+    /// Called only when `observedContextEvents` contains `.didSave`.
     open func context(
         _ context: Context,
-        didSave changes: ManagedObjectChanges
+        didSave changes: ManagedObjectChangeSet
         )
     {
         
@@ -344,6 +1165,11 @@ open class PersistentController {
     // object.
     private let _savingContext: NSManagedObjectContext
     
+    /// The label of the saving context's private queue, which tells
+    /// whether a caller is running on it. Accessed on `_saveQueue`. `nil`
+    /// until the queue runs its first block.
+    private var _savingContextQueueLabel: String?
+    
     /// All operations happen in this serial queue.
     ///
     /// - Notes: Dispatching all operations in one queue could simply make them
@@ -354,6 +1180,48 @@ open class PersistentController {
     
     private unowned let _managedObjectModel: NSManagedObjectModel
     
+    /// Prepared fetch request templates and object IDs fetched with them.
+    internal let _fetchRequestTemplateCache: _FetchRequestTemplateCache
+    
+    private var _observesObjectsDidChange: Bool = false
+    
+    private var _observesWillSave: Bool = false
+    
+    private var _observesDidSave: Bool = false
+    
+    /// Guards the states of coalesced savings. Never waits on other
+    /// queues, thus it is safe to be synchronized with from anywhere.
+    private let _saveQueue = DispatchQueue(
+        label: "com.WeZZard.Nest.PersistentController.SaveQueue"
+    )
+    
+    private var _pendingSaveCompletionHandlers: [(Error?) -> Void] = []
+    
+    private var _pendingSaveCount: Int = 0
+    
+    /// Increased on each flush, which invalidates the scheduled one.
+    private var _saveFlushGeneration: Int = 0
+    
+    /// Entered until the persistent store was added.
+    private let _persistentStoreLoadingGroup = DispatchGroup()
+    
+    /// Guarded by `_readContextPoolQueue`.
+    private var _storeLoadingState: StoreLoadingState = .loading
+    
+    /// Guards the read context pool and the store loading state. Never
+    /// waits on other queues.
+    private let _readContextPoolQueue = DispatchQueue(
+        label: "com.WeZZard.Nest.PersistentController.ReadContextPoolQueue"
+    )
+    
+    private var _readContextPool: [_ReadContextPoolEntry] = []
+    
+    private var _readContextPoolSize: Int
+        = ProcessInfo.processInfo.activeProcessorCount
+    
+    /// How `save(with:)` saves. `.immediate` by default.
+    public var saveMode: SaveMode = .immediate
+    
     /// Could be used for debugging.
     public var name: String = ""
     
@@ -363,6 +1231,31 @@ open class PersistentController {
         case forSaving(NSManagedObjectContext)
     }
     
+    public enum StoreLoadingState {
+        case loading
+        case loaded
+        case failed(Error)
+    }
+    
+    public enum SaveMode {
+        /// Saves the fetching context and the saving context on each call.
+        case immediate
+        /// Coalesces the savings within `window` seconds since the first
+        /// deferred one, or until the fetching context has
+        /// `changeCountThreshold` changes, and then saves in the background.
+        case coalescing(window: TimeInterval, changeCountThreshold: Int)
+    }
+    
+    private final class _ReadContextPoolEntry {
+        let context: NSManagedObjectContext
+        
+        var transactionCount: Int = 0
+        
+        init(context: NSManagedObjectContext) {
+            self.context = context
+        }
+    }
+    
     public typealias ManagedObjectChanges
         = [NSManagedObjectChangeKey: Set<NSManagedObject>]
     
@@ -403,6 +1296,14 @@ extension SingletonPersistentController where
 {
     public static func launch() { _ = shared }
     
+    public static func whenStoreLoaded(
+        on queue: DispatchQueue = .main,
+        _ handler: @escaping (_ error: Error?) -> Void
+        )
+    {
+        shared.whenStoreLoaded(on: queue, handler)
+    }
+    
     public static func save(
         with comletionHandler: ((_ error: Error?) -> Void)? = nil
         )
@@ -410,6 +1311,14 @@ extension SingletonPersistentController where
         shared.save(with: comletionHandler)
     }
     
+    public static func flush() {
+        shared.flush()
+    }
+    
+    public static var metrics: PersistentControllerMetrics {
+        return shared.metrics
+    }
+    
     public static func perform(
         _ transaction: @escaping (NSManagedObjectContext) -> Void
         )
@@ -417,6 +1326,81 @@ extension SingletonPersistentController where
         shared.perform(transaction)
     }
     
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    public static func batchInsert(
+        entityName: String,
+        objects: [[String: Any]],
+        chunkSize: Int = 1024,
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)? = nil
+        )
+    {
+        shared.batchInsert(
+            entityName: entityName,
+            objects: objects,
+            chunkSize: chunkSize,
+            completionHandler: completionHandler
+        )
+    }
+    
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    public static func batchUpdate(
+        entityName: String,
+        predicate: NSPredicate? = nil,
+        propertiesToUpdate: [AnyHashable : Any],
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)? = nil
+        )
+    {
+        shared.batchUpdate(
+            entityName: entityName,
+            predicate: predicate,
+            propertiesToUpdate: propertiesToUpdate,
+            completionHandler: completionHandler
+        )
+    }
+    
+    @available(
+    iOSApplicationExtension 9.0,
+    OSXApplicationExtension 10.11,
+    tvOS 9.0,
+    watchOS 2.0,
+    *)
+    public static func batchDelete(
+        entityName: String,
+        predicate: NSPredicate? = nil,
+        completionHandler: ((_ objectIDs: [NSManagedObjectID], _ error: Error?) -> Void)? = nil
+        )
+    {
+        shared.batchDelete(
+            entityName: entityName,
+            predicate: predicate,
+            completionHandler: completionHandler
+        )
+    }
+    
+    public static func performRead(
+        _ transaction: @escaping (NSManagedObjectContext) -> Void
+        )
+    {
+        shared.performRead(transaction)
+    }
+    
+    public static func performReadAndWait<R>(
+        _ transaction: @escaping (NSManagedObjectContext) -> R
+        ) -> R
+    {
+        return shared.performReadAndWait(transaction)
+    }
+    
     public static func performAndWait<R>(
         _ transaction: @escaping (NSManagedObjectContext) -> R
         ) -> R
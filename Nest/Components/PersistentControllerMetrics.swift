@@ -0,0 +1,249 @@
+//
+//  PersistentControllerMetrics.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import Dispatch
+import Foundation
+
+/// A histogram of durations with power-of-two microsecond buckets, which
+/// records in constant time and space.
+public struct LatencyHistogram {
+    /// The bucket at `index` counts durations in
+    /// [2^index, 2^(index + 1)) microseconds. The first bucket also counts
+    /// durations shorter than 1 microsecond.
+    public private(set) var buckets: [Int]
+    
+    public private(set) var count: Int = 0
+    
+    public private(set) var totalDuration: TimeInterval = 0
+    
+    public private(set) var maximumDuration: TimeInterval = 0
+    
+    public init() {
+        buckets = Array(repeating: 0, count: LatencyHistogram.bucketCount)
+    }
+    
+    public static let bucketCount = 32
+    
+    public var averageDuration: TimeInterval {
+        return count == 0 ? 0 : totalDuration / TimeInterval(count)
+    }
+    
+    /// Returns the upper bound of the bucket containing the `percentile`
+    /// (0 to 1) of recorded durations.
+    public func duration(atPercentile percentile: Double) -> TimeInterval {
+        guard count > 0 else { return 0 }
+        
+        let rank = Int((Double(count) * min(max(percentile, 0), 1)).rounded(.up))
+        
+        var accumulated = 0
+        for (index, each) in buckets.enumerated() {
+            accumulated += each
+            if accumulated >= max(rank, 1) {
+                return min(
+                    TimeInterval(UInt64(1) << UInt64(index + 1)) / 1_000_000,
+                    maximumDuration
+                )
+            }
+        }
+        
+        return maximumDuration
+    }
+    
+    internal mutating func record(nanoseconds: UInt64) {
+        let microseconds = nanoseconds / 1_000
+        let index = microseconds == 0
+            ? 0
+            : min(
+                Int(flsll(Int64(bitPattern: microseconds))) - 1,
+                LatencyHistogram.bucketCount - 1
+        )
+        
+        let duration = TimeInterval(nanoseconds) / 1_000_000_000
+        
+        buckets[index] += 1
+        count += 1
+        totalDuration += duration
+        maximumDuration = max(maximumDuration, duration)
+    }
+}
+
+/// Latencies of transactions and savings of a `PersistentController`.
+///
+/// - Notes: Recording costs two reads of the monotonic clock and one
+/// short critical section per transaction or saving, thus metrics are
+/// enabled by default.
+public final class PersistentControllerMetrics {
+    public enum TransactionKind {
+        case perform
+        case performAndWait
+        case save(ContextRole)
+    }
+    
+    public enum ContextRole {
+        case fetching
+        case saving
+        /// Batch insertions, updates and deletions, which write to the
+        /// persistent store without the saving context.
+        case batch
+    }
+    
+    public struct Transaction {
+        public let kind: TransactionKind
+        
+        /// How long the transaction waited for the operation queue and the
+        /// context's queue. Zero for savings.
+        public let queueWait: TimeInterval
+        
+        public let execution: TimeInterval
+    }
+    
+    public struct SaveStatistics {
+        public internal(set) var durations = LatencyHistogram()
+        
+        public internal(set) var insertedObjectCount: Int = 0
+        
+        public internal(set) var updatedObjectCount: Int = 0
+        
+        public internal(set) var deletedObjectCount: Int = 0
+    }
+    
+    public struct Snapshot {
+        public internal(set) var queueWait = LatencyHistogram()
+        
+        public internal(set) var execution = LatencyHistogram()
+        
+        public internal(set) var fetchingContextSaves = SaveStatistics()
+        
+        public internal(set) var savingContextSaves = SaveStatistics()
+        
+        public internal(set) var batchSaves = SaveStatistics()
+    }
+    
+    public var isEnabled: Bool {
+        get { return _queue.sync { _isEnabled } }
+        set { _queue.sync { _isEnabled = newValue } }
+    }
+    
+    /// Transactions and savings taking longer than this, in seconds, are
+    /// reported to `slowTransactionHandler`. Queue waits are included.
+    public var slowTransactionThreshold: TimeInterval {
+        get { return _queue.sync { _slowTransactionThreshold } }
+        set { _queue.sync { _slowTransactionThreshold = newValue } }
+    }
+    
+    /// Called on the queue which ran the slow transaction.
+    public var slowTransactionHandler: ((Transaction) -> Void)? {
+        get { return _queue.sync { _slowTransactionHandler } }
+        set { _queue.sync { _slowTransactionHandler = newValue } }
+    }
+    
+    public var snapshot: Snapshot {
+        return _queue.sync { _snapshot }
+    }
+    
+    public func reset() {
+        _queue.sync { _snapshot = Snapshot() }
+    }
+    
+    // MARK: Recording
+    internal static func now() -> UInt64 {
+        return DispatchTime.now().uptimeNanoseconds
+    }
+    
+    internal func recordTransaction(
+        _ kind: TransactionKind,
+        enqueued: UInt64,
+        started: UInt64,
+        finished: UInt64
+        )
+    {
+        let queueWait = started &- enqueued
+        let execution = finished &- started
+        
+        let handler = _queue.sync { () -> ((Transaction) -> Void)? in
+            guard _isEnabled else { return nil }
+            _snapshot.queueWait.record(nanoseconds: queueWait)
+            _snapshot.execution.record(nanoseconds: execution)
+            return _slowTransactionHandler(
+                forNanoseconds: queueWait + execution
+            )
+        }
+        
+        handler?(
+            Transaction(
+                kind: kind,
+                queueWait: TimeInterval(queueWait) / 1_000_000_000,
+                execution: TimeInterval(execution) / 1_000_000_000
+            )
+        )
+    }
+    
+    internal func recordSave(
+        _ role: ContextRole,
+        started: UInt64,
+        finished: UInt64,
+        insertedObjectCount: Int,
+        updatedObjectCount: Int,
+        deletedObjectCount: Int
+        )
+    {
+        let duration = finished &- started
+        
+        let handler = _queue.sync { () -> ((Transaction) -> Void)? in
+            guard _isEnabled else { return nil }
+            
+            func record(_ statistics: inout SaveStatistics) {
+                statistics.durations.record(nanoseconds: duration)
+                statistics.insertedObjectCount += insertedObjectCount
+                statistics.updatedObjectCount += updatedObjectCount
+                statistics.deletedObjectCount += deletedObjectCount
+            }
+            
+            switch role {
+            case .fetching: record(&_snapshot.fetchingContextSaves)
+            case .saving:   record(&_snapshot.savingContextSaves)
+            case .batch:    record(&_snapshot.batchSaves)
+            }
+            
+            return _slowTransactionHandler(forNanoseconds: duration)
+        }
+        
+        handler?(
+            Transaction(
+                kind: .save(role),
+                queueWait: 0,
+                execution: TimeInterval(duration) / 1_000_000_000
+            )
+        )
+    }
+    
+    /// Always called on `_queue`.
+    private func _slowTransactionHandler(forNanoseconds nanoseconds: UInt64)
+        -> ((Transaction) -> Void)?
+    {
+        guard let handler = _slowTransactionHandler,
+            TimeInterval(nanoseconds) / 1_000_000_000
+                >= _slowTransactionThreshold else
+        {
+            return nil
+        }
+        return handler
+    }
+    
+    private let _queue = DispatchQueue(
+        label: "com.WeZZard.Nest.PersistentController.Metrics"
+    )
+    
+    private var _isEnabled: Bool = true
+    
+    private var _slowTransactionThreshold: TimeInterval = 0.1
+    
+    private var _slowTransactionHandler: ((Transaction) -> Void)?
+    
+    private var _snapshot = Snapshot()
+}
@@ -90,6 +90,43 @@ extension NSCoder {
     {
         value?.encode(to: self, for: key)
     }
+    
+    // MARK: Bulk Coding
+    /// Encodes `values` as one bulk coded `NSData` instead of an `NSArray`
+    /// of boxed values.
+    public func encode<T: ObjCNormalizedBulkCoding>(
+        _ values: [T]?, for key: String
+        )
+    {
+        values?.withUnsafeBufferPointer {
+            encode(_makeBulkCodedData($0) as NSData, forKey: key)
+        }
+    }
+    
+    /// Encodes `values` as one bulk coded `NSData` instead of an `NSArray`
+    /// of boxed values.
+    public func encode<T: ObjCNormalizedBulkCoding>(
+        _ values: ContiguousArray<T>?, for key: String
+        )
+    {
+        values?.withUnsafeBufferPointer {
+            encode(_makeBulkCodedData($0) as NSData, forKey: key)
+        }
+    }
+    
+    /// Encodes `values` as one bulk coded `NSData`, which can be decoded
+    /// with `decodeBulkOrThrow(for:)` or as an `Array` or a
+    /// `ContiguousArray`.
+    ///
+    /// - Note: `encode(_:for:)` keeps encoding an `UnsafeBufferPointer` as
+    /// raw bytes, which is the format of existing archives.
+    public func encodeBulk<T: ObjCNormalizedBulkCoding>(
+        _ values: UnsafeBufferPointer<T>?, for key: String
+        )
+    {
+        guard let values = values else { return }
+        encode(_makeBulkCodedData(values) as NSData, forKey: key)
+    }
 }
 
 //MARK: - Throwing Decoding
@@ -222,6 +259,118 @@ extension NSCoder {
             throw ObjCNormalizedCodingDecodeError.noValueForKey(key: key)
         }
     }
+    
+    // MARK: Bulk Coding
+    public func decodeOrThrow<T: ObjCNormalizedBulkCoding>(
+        for key: String
+        ) throws -> [T]!
+    {
+        return try _decodeBulkCodedCollection(for: key)
+    }
+    
+    public func decodeOrThrow<T: ObjCNormalizedBulkCoding>(
+        for key: String
+        ) throws -> ContiguousArray<T>!
+    {
+        return try _decodeBulkCodedCollection(for: key)
+    }
+    
+    /// Decodes a value encoded by `encodeBulk(_:for:)` or as an `Array` or
+    /// a `ContiguousArray` into a newly allocated buffer. The caller owns
+    /// the returned buffer and is responsible to deallocate it with
+    /// `deallocate(capacity:)` of its base address.
+    public func decodeBulkOrThrow<T: ObjCNormalizedBulkCoding>(
+        for key: String
+        ) throws -> UnsafeMutableBufferPointer<T>!
+    {
+        guard containsValue(forKey: key) else {
+            throw ObjCNormalizedCodingDecodeError.noValueForKey(key: key)
+        }
+        
+        let object = decodeObject(forKey: key)
+        
+        if let data = object as? Data {
+            let decoded = try data.withUnsafeBytes {
+                (bytes: UnsafePointer<UInt8>)
+                    -> UnsafeMutableBufferPointer<T>? in
+                guard let elements = try _BulkCodedElements<T>(
+                    bytes: UnsafeRawPointer(bytes), length: data.count,
+                    for: key
+                    ) else { return nil }
+                
+                let buffer = UnsafeMutablePointer<T>
+                    .allocate(capacity: elements.count)
+                
+                do {
+                    try elements.initialize(buffer, for: key)
+                } catch let error {
+                    buffer.deallocate(capacity: elements.count)
+                    throw error
+                }
+                
+                return UnsafeMutableBufferPointer(
+                    start: buffer, count: elements.count
+                )
+            }
+            
+            if let decoded = decoded {
+                return decoded
+            }
+        }
+        
+        // Archives made before bulk coding store an `NSArray` of boxed
+        // values.
+        if let elements = object as? [T] {
+            let buffer = UnsafeMutablePointer<T>
+                .allocate(capacity: elements.count)
+            buffer.initialize(from: elements)
+            return UnsafeMutableBufferPointer(
+                start: buffer, count: elements.count
+            )
+        }
+        
+        throw ObjCNormalizedCodingDecodeError.typeCastingFailed(
+            key: key, value: object ?? NSNull(),
+            type: UnsafeMutableBufferPointer<T>.self
+        )
+    }
+    
+    private func _decodeBulkCodedCollection<
+        T: ObjCNormalizedBulkCoding, C: RangeReplaceableCollection
+        >(for key: String) throws -> C where C.Iterator.Element == T
+    {
+        guard containsValue(forKey: key) else {
+            throw ObjCNormalizedCodingDecodeError.noValueForKey(key: key)
+        }
+        
+        let object = decodeObject(forKey: key)
+        
+        if let data = object as? Data {
+            var collection = C()
+            
+            let isBulkCoded = try data.withUnsafeBytes {
+                (bytes: UnsafePointer<UInt8>) -> Bool in
+                try _appendBulkCodedElements(
+                    from: UnsafeRawPointer(bytes), length: data.count,
+                    to: &collection, for: key
+                )
+            }
+            
+            if isBulkCoded {
+                return collection
+            }
+        }
+        
+        // Archives made before bulk coding store an `NSArray` of boxed
+        // values.
+        if let elements = object as? [T] {
+            return C(elements)
+        }
+        
+        throw ObjCNormalizedCodingDecodeError.typeCastingFailed(
+            key: key, value: object ?? NSNull(), type: C.self
+        )
+    }
 }
 
 //MARK: - Maybe Decoding
@@ -317,4 +466,21 @@ extension NSCoder {
     {
         return try? decodeOrThrow(for: key, with: classes)
     }
+    
+    // MARK: Bulk Coding
+    public func decode<T: ObjCNormalizedBulkCoding>(for key: String) -> [T]? {
+        return try? decodeOrThrow(for: key)
+    }
+    
+    public func decode<T: ObjCNormalizedBulkCoding>(for key: String)
+        -> ContiguousArray<T>?
+    {
+        return try? decodeOrThrow(for: key)
+    }
+    
+    public func decodeBulk<T: ObjCNormalizedBulkCoding>(for key: String)
+        -> UnsafeMutableBufferPointer<T>?
+    {
+        return try? decodeBulkOrThrow(for: key)
+    }
 }
@@ -9,11 +9,13 @@
 import Foundation
 import ObjectiveC
 import SwiftExt
+import Nest.AtomicUtilities
 
 extension RunLoop {
     // MARK: Task Schedulers
     /// Schedule a task on the run-loop in the specified mode at the 
-    /// specified time. This function is not thread safe.
+    /// specified time. This function is thread safe, and wakes up the
+    /// run-loop if it is waiting.
     ///
     /// - Parameter mode: The run-loop mode that the run-loop is in which
     /// can excute this task. `.defaultRunLoopMode` by default.
@@ -21,18 +23,34 @@ extension RunLoop {
     /// - Parameter timing: The timing to dispatch the task. 
     /// `.nextLoopBegan` by default.
     ///
+    /// - Parameter priority: Tasks of higher priority run first.
+    /// `.normal` by default.
+    ///
+    /// - Parameter cost: The estimated duration of the task in seconds.
+    /// A task is deferred when its cost exceeds the rest of the run-loop's
+    /// `taskTimeBudget`. `0` by default.
+    ///
     /// - Parameter closure: The task
     public func schedule(
         in mode: RunLoopMode = .defaultRunLoopMode,
         when timings: Timings = .nextLoopBegan,
+        priority: TaskPriority = .normal,
+        cost: TimeInterval = 0,
         do closure: @escaping ()->Void
         )
     {
-        schedule(in: [mode], when: timings, do: closure)
+        schedule(
+            in: [mode],
+            when: timings,
+            priority: priority,
+            cost: cost,
+            do: closure
+        )
     }
     
     /// Schedule a task on the run-loop in the specified modes at the
-    /// specified time. This function is not thread safe.
+    /// specified time. This function is thread safe, and wakes up the
+    /// run-loop if it is waiting.
     ///
     /// - Parameter mode: The run-loop modes that the run-loop is in which
     /// can excute this task.
@@ -40,18 +58,34 @@ extension RunLoop {
     /// - Parameter timing: The timing to dispatch the task.
     /// `.nextLoopBegan` by default.
     ///
+    /// - Parameter priority: Tasks of higher priority run first.
+    /// `.normal` by default.
+    ///
+    /// - Parameter cost: The estimated duration of the task in seconds.
+    /// A task is deferred when its cost exceeds the rest of the run-loop's
+    /// `taskTimeBudget`. `0` by default.
+    ///
     /// - Parameter closure: The task
     public func schedule(
         in modes: RunLoopMode...,
         when timings: Timings = .nextLoopBegan,
+        priority: TaskPriority = .normal,
+        cost: TimeInterval = 0,
         do closure: @escaping ()->Void
         )
     {
-        schedule(in: modes, when: timings, do: closure)
+        schedule(
+            in: modes,
+            when: timings,
+            priority: priority,
+            cost: cost,
+            do: closure
+        )
     }
     
     /// Schedule a task on the run-loop in the specified modes at the
-    /// specified time. This function is not thread safe.
+    /// specified time. This function is thread safe, and wakes up the
+    /// run-loop if it is waiting.
     ///
     /// - Parameter mode: The run-loop modes that the run-loop is in which
     /// can excute this task.
@@ -59,49 +93,162 @@ extension RunLoop {
     /// - Parameter timing: The timing to dispatch the task.
     /// `.nextLoopBegan` by default.
     ///
+    /// - Parameter priority: Tasks of higher priority run first.
+    /// `.normal` by default.
+    ///
+    /// - Parameter cost: The estimated duration of the task in seconds.
+    /// A task is deferred when its cost exceeds the rest of the run-loop's
+    /// `taskTimeBudget`. `0` by default.
+    ///
     /// - Parameter closure: The task
     public func schedule<Modes: Sequence>(
         in modes: Modes,
         when timings: Timings = .nextLoopBegan,
+        priority: TaskPriority = .normal,
+        cost: TimeInterval = 0,
         do closure: @escaping ()->Void
         ) where Modes.Iterator.Element == RunLoopMode
     {
-        let task = _Task(timings: timings, closure: closure)
-        
+        _schedule(
+            _Task(
+                timings: timings,
+                priority: priority,
+                cost: cost,
+                coalescingKey: nil,
+                coalescingPolicy: .replace,
+                closure: closure
+            ),
+            in: modes
+        )
+    }
+    
+    /// Schedule a task with a coalescing key on the run-loop in the
+    /// specified mode at the specified time. Scheduling a task with the key
+    /// of a pending task in the same mode coalesces them, thus N
+    /// schedulings cost one execution. This function is thread safe.
+    ///
+    /// - Parameter coalescingKey: The key of the logical work.
+    ///
+    /// - Parameter policy: How to coalesce with the pending task, whose
+    /// timings, priority and cost are kept. `.replace` by default.
+    ///
+    /// - Parameter closure: The task
+    public func schedule(
+        in mode: RunLoopMode = .defaultRunLoopMode,
+        when timings: Timings = .nextLoopBegan,
+        priority: TaskPriority = .normal,
+        cost: TimeInterval = 0,
+        coalescingKey: AnyHashable,
+        policy: TaskCoalescingPolicy = .replace,
+        do closure: @escaping ()->Void
+        )
+    {
+        schedule(
+            in: [mode],
+            when: timings,
+            priority: priority,
+            cost: cost,
+            coalescingKey: coalescingKey,
+            policy: policy,
+            do: closure
+        )
+    }
+    
+    /// Schedule a task with a coalescing key on the run-loop in the
+    /// specified modes at the specified time. Scheduling a task with the
+    /// key of a pending task in the same mode coalesces them, thus N
+    /// schedulings cost one execution. This function is thread safe.
+    ///
+    /// - Parameter coalescingKey: The key of the logical work.
+    ///
+    /// - Parameter policy: How to coalesce with the pending task, whose
+    /// timings, priority and cost are kept. `.replace` by default.
+    ///
+    /// - Parameter closure: The task
+    public func schedule<Modes: Sequence>(
+        in modes: Modes,
+        when timings: Timings = .nextLoopBegan,
+        priority: TaskPriority = .normal,
+        cost: TimeInterval = 0,
+        coalescingKey: AnyHashable,
+        policy: TaskCoalescingPolicy = .replace,
+        do closure: @escaping ()->Void
+        ) where Modes.Iterator.Element == RunLoopMode
+    {
+        _schedule(
+            _Task(
+                timings: timings,
+                priority: priority,
+                cost: cost,
+                coalescingKey: coalescingKey,
+                coalescingPolicy: policy,
+                closure: closure
+            ),
+            in: modes
+        )
+    }
+    
+    private func _schedule<Modes: Sequence>(_ task: _Task, in modes: Modes)
+        where Modes.Iterator.Element == RunLoopMode
+    {
         // Use Set to ensure uniqueness, which avoiding redundant retaining.
         for mode in Set(modes) {
-            if let scheduler = _schedulers[mode] {
-                scheduler.schedule(task)
-            } else {
-                let scheduler = _Scheduler(runLoop: self, mode: mode)
-                _schedulers[mode] = scheduler
-                scheduler.schedule(task)
-                
-            }
+            _scheduler(for: mode).schedule(task)
         }
     }
     
-    // MARK: Utilities
-    private typealias Schedulers = [RunLoopMode : _Scheduler]
+    /// The time in seconds that scheduled tasks may take in one run-loop
+    /// activity of a mode. Tasks beyond the budget are deferred to the
+    /// next time the run-loop is about to wait, and the run-loop is woken
+    /// up to run them. Unlimited by default. Set it on the run-loop's
+    /// thread.
+    public var taskTimeBudget: TimeInterval {
+        get { return _schedulerRegistry.taskTimeBudget }
+        set { _schedulerRegistry.taskTimeBudget = newValue }
+    }
     
-    private var _schedulers: Schedulers {
-        get {
-            if let assocObj = objc_getAssociatedObject(self, &schedulersKey) {
-                return (assocObj as! ObjCAssociated<Schedulers>).value
+    // MARK: Utilities
+    /// Returns the scheduler for `mode`, creating it if needed. Existing
+    /// schedulers are looked up without locking since tasks might be
+    /// scheduled from any thread; creation happens under
+    /// `_schedulersQueue`.
+    private func _scheduler(for mode: RunLoopMode) -> _Scheduler {
+        let registry = _schedulerRegistry
+        
+        if let scheduler = registry.scheduler(for: mode) {
+            return scheduler
+        }
+        
+        return _schedulersQueue.sync { () -> _Scheduler in
+            if let scheduler = registry.scheduler(for: mode) {
+                return scheduler
             } else {
-                return [:]
+                let scheduler = _Scheduler(
+                    runLoop: self, registry: registry, mode: mode
+                )
+                registry.insert(scheduler, for: mode)
+                return scheduler
             }
         }
-        set {
-            if let assocObj = objc_getAssociatedObject(self, &schedulersKey) {
-                (assocObj as! ObjCAssociated<Schedulers>).value = newValue
+    }
+    
+    private var _schedulerRegistry: _SchedulerRegistry {
+        if let registry = objc_getAssociatedObject(self, &schedulersKey) {
+            return registry as! _SchedulerRegistry
+        }
+        
+        return _schedulersQueue.sync { () -> _SchedulerRegistry in
+            if let registry = objc_getAssociatedObject(self, &schedulersKey) {
+                return registry as! _SchedulerRegistry
             } else {
+                let registry = _SchedulerRegistry()
                 objc_setAssociatedObject(
                     self,
                     &schedulersKey,
-                    ObjCAssociated(newValue),
-                    .OBJC_ASSOCIATION_RETAIN_NONATOMIC
+                    registry,
+                    .OBJC_ASSOCIATION_RETAIN
                 )
+                return registry
             }
         }
     }
@@ -142,36 +289,288 @@ extension RunLoop {
         }
     }
     
+    /// Schedulers of a run-loop by mode, which are read without locking.
+    ///
+    /// - Notes: Readers atomically load the current snapshot, an immutable
+    /// dictionary. Writers publish a new snapshot under `_schedulersQueue`.
+    /// Replaced snapshots are kept until the registry dies, so a reader
+    /// never sees a released one. There is one snapshot for each mode
+    /// used with the run-loop.
+    private final class _SchedulerRegistry {
+        private final class _Snapshot {
+            let schedulers: [RunLoopMode : _Scheduler]
+            
+            init(schedulers: [RunLoopMode : _Scheduler]) {
+                self.schedulers = schedulers
+            }
+        }
+        
+        /// An unmanaged `_Snapshot`, accessed atomically.
+        private let _current: UnsafeMutablePointer<UnsafeMutableRawPointer?>
+        
+        /// Only accessed on `_schedulersQueue`.
+        private var _snapshots: [_Snapshot] = []
+        
+        /// Backs `RunLoop.taskTimeBudget`, read by the schedulers on each
+        /// run-loop activity. Only accessed on the run-loop's thread.
+        fileprivate var taskTimeBudget: TimeInterval = .infinity
+        
+        fileprivate init() {
+            _current = UnsafeMutablePointer.allocate(capacity: 1)
+            _current.initialize(to: nil)
+        }
+        
+        deinit {
+            _current.deinitialize()
+            _current.deallocate(capacity: 1)
+        }
+        
+        fileprivate var schedulers: [RunLoopMode : _Scheduler] {
+            guard let current = _NestAtomicLoadPointer(_current) else {
+                return [:]
+            }
+            return Unmanaged<_Snapshot>.fromOpaque(current)
+                .takeUnretainedValue().schedulers
+        }
+        
+        /// Called from any thread.
+        fileprivate func scheduler(for mode: RunLoopMode) -> _Scheduler? {
+            guard let current = _NestAtomicLoadPointer(_current) else {
+                return nil
+            }
+            return Unmanaged<_Snapshot>.fromOpaque(current)
+                .takeUnretainedValue().schedulers[mode]
+        }
+        
+        /// Called on `_schedulersQueue`.
+        fileprivate func insert(
+            _ scheduler: _Scheduler, for mode: RunLoopMode
+            )
+        {
+            var schedulers = _snapshots.last?.schedulers ?? [:]
+            schedulers[mode] = scheduler
+            
+            let snapshot = _Snapshot(schedulers: schedulers)
+            _snapshots.append(snapshot)
+            
+            _NestAtomicStorePointer(
+                _current, Unmanaged.passUnretained(snapshot).toOpaque()
+            )
+        }
+    }
+    
+    /// A lock-free multi-producer single-consumer queue of tasks.
+    ///
+    /// - Notes: Producers push onto an intrusive stack with compare-and-swap.
+    /// The consumer detaches the whole stack at once and reverses it into
+    /// the order of submission. Since nodes are never popped one by one,
+    /// the stack is free from the ABA problem.
+    private final class _SubmissionQueue {
+        private final class _Node {
+            let task: _Task
+            
+            var next: UnsafeMutableRawPointer?
+            
+            init(task: _Task) {
+                self.task = task
+            }
+        }
+        
+        private let _head: UnsafeMutablePointer<UnsafeMutableRawPointer?>
+        
+        fileprivate init() {
+            _head = UnsafeMutablePointer.allocate(capacity: 1)
+            _head.initialize(to: nil)
+        }
+        
+        deinit {
+            _detach { _ in }
+            _head.deinitialize()
+            _head.deallocate(capacity: 1)
+        }
+        
+        /// Called from any thread.
+        fileprivate func push(_ task: _Task) {
+            let node = _Node(task: task)
+            let opaqueNode = Unmanaged.passRetained(node).toOpaque()
+            
+            var head = _NestAtomicLoadPointer(_head)
+            repeat {
+                node.next = head
+            } while !_NestAtomicCompareAndSwapPointer(_head, &head, opaqueNode)
+        }
+        
+        /// Called by the consumer only. Calls `body` with tasks in the order
+        /// of submission.
+        fileprivate func popAll(_ body: (_Task) -> Void) {
+            _detach(body)
+        }
+        
+        private func _detach(_ body: (_Task) -> Void) {
+            guard _NestAtomicLoadPointer(_head) != nil else { return }
+            
+            var head = _NestAtomicExchangePointer(_head, nil)
+            
+            // Reverses the detached stack in place.
+            var reversed: UnsafeMutableRawPointer? = nil
+            while let current = head {
+                let node = Unmanaged<_Node>.fromOpaque(current)
+                    .takeUnretainedValue()
+                head = node.next
+                node.next = reversed
+                reversed = current
+            }
+            
+            while let current = reversed {
+                let node = Unmanaged<_Node>.fromOpaque(current)
+                    .takeRetainedValue()
+                reversed = node.next
+                body(node.task)
+            }
+        }
+    }
+    
+    public enum TaskCoalescingPolicy {
+        /// The closure of the pending task is replaced with the new one.
+        case replace
+        /// The closure of the pending task is kept and the new one is
+        /// dropped.
+        case keepPending
+    }
+    
+    public enum TaskPriority: Int, Comparable {
+        case low
+        case normal
+        case high
+        
+        public static func < (lhs: TaskPriority, rhs: TaskPriority) -> Bool {
+            return lhs.rawValue < rhs.rawValue
+        }
+    }
+    
     private class _Task {
-        fileprivate init(timings: Timings, closure: @escaping () -> Void) {
+        fileprivate init(
+            timings: Timings,
+            priority: TaskPriority,
+            cost: TimeInterval,
+            coalescingKey: AnyHashable?,
+            coalescingPolicy: TaskCoalescingPolicy,
+            closure: @escaping () -> Void
+            )
+        {
             expectedActivities = CFRunLoopActivity(runLoopTimings: timings)
+            self.priority = priority
+            self.cost = cost
+            self.coalescingKey = coalescingKey
+            self.coalescingPolicy = coalescingPolicy
             isExecuted = false
+            isDeferred = false
             _closure = closure
         }
         
         fileprivate func execute() {
-            _closure()
+            _closure?()
             isExecuted = true
+            // Buckets of other activities might still hold the task.
+            _closure = nil
+        }
+        
+        /// Coalesces `task` of the same coalescing key into the receiver.
+        fileprivate func coalesce(_ task: _Task) {
+            switch task.coalescingPolicy {
+            case .replace:      _closure = task._closure
+            case .keepPending:  break
+            }
         }
         
         fileprivate let expectedActivities: CFRunLoopActivity
         
+        fileprivate let priority: TaskPriority
+        
+        fileprivate let cost: TimeInterval
+        
+        fileprivate let coalescingKey: AnyHashable?
+        
+        fileprivate let coalescingPolicy: TaskCoalescingPolicy
+        
         fileprivate private(set) var isExecuted: Bool
         
-        private let _closure: () -> Void
+        /// Deferred tasks also run when the run-loop is about to wait.
+        fileprivate var isDeferred: Bool
+        
+        private var _closure: (() -> Void)?
+    }
+    
+    /// A FIFO ring buffer of tasks, which reuses its storage once grown.
+    private struct _TaskRingBuffer {
+        private var _storage = ContiguousArray<_Task?>(
+            repeating: nil, count: 16
+        )
+        
+        private var _head = 0
+        
+        fileprivate private(set) var count = 0
+        
+        fileprivate mutating func append(_ task: _Task) {
+            if count == _storage.count {
+                _grow()
+            }
+            _storage[(_head + count) & (_storage.count - 1)] = task
+            count += 1
+        }
+        
+        fileprivate mutating func removeFirst() -> _Task {
+            precondition(count > 0)
+            let task = _storage[_head]!
+            _storage[_head] = nil
+            _head = (_head + 1) & (_storage.count - 1)
+            count -= 1
+            return task
+        }
+        
+        private mutating func _grow() {
+            // Capacity is always a power of two.
+            var storage = ContiguousArray<_Task?>(
+                repeating: nil, count: _storage.count * 2
+            )
+            for index in 0..<count {
+                storage[index] = _storage[(_head + index) & (_storage.count - 1)]
+            }
+            _storage = storage
+            _head = 0
+        }
     }
     
     private class _Scheduler {
         private unowned let _runLoop: RunLoop
-        private var _tasks: [_Task] = []
+        /// Owns the scheduler, and holds the task time budget.
+        private unowned let _registry: _SchedulerRegistry
+        /// One bucket for each pair of activity and priority. A task
+        /// expecting multiple activities is in multiple buckets, and runs
+        /// only once since executed tasks are dropped by the other buckets.
+        /// Only accessed on the run-loop's thread.
+        private var _buckets = [_TaskRingBuffer](
+            repeating: _TaskRingBuffer(),
+            count: _Scheduler._activities.count * _Scheduler._priorityCount
+        )
+        private let _submissionQueue = _SubmissionQueue()
+        /// Pending tasks with coalescing keys. Only accessed on the
+        /// run-loop's thread.
+        private var _coalescableTasks: [AnyHashable : _Task] = [:]
         private let _mode: RunLoopMode
+        private let _cfRunLoop: CFRunLoop
         
         private var _context: CFRunLoopObserverContext!
         private var _observer: CFRunLoopObserver!
         
-        fileprivate init(runLoop: RunLoop, mode: RunLoopMode) {
+        fileprivate init(
+            runLoop: RunLoop, registry: _SchedulerRegistry, mode: RunLoopMode
+            )
+        {
             _runLoop = runLoop
+            _registry = registry
             _mode = mode
+            _cfRunLoop = runLoop.getCFRunLoop()
             
             _context = CFRunLoopObserverContext(
                 version: 0,
@@ -199,30 +598,134 @@ extension RunLoop {
             )
         }
         
+        /// Called from any thread.
         fileprivate func schedule(_ task: _Task) {
-            _tasks.append(task)
+            _submissionQueue.push(task)
+            CFRunLoopWakeUp(_cfRunLoop)
         }
         
         fileprivate func invalidate() {
             CFRunLoopObserverInvalidate(_observer)
         }
         
+        private static let _activities: [CFRunLoopActivity] = [
+            .beforeTimers, .beforeWaiting, .afterWaiting
+        ]
+        
+        private static let _priorityCount = TaskPriority.high.rawValue + 1
+        
+        private static let _beforeWaitingIndex = 1
+        
+        private static func _bucketIndex(
+            activityIndex: Int, priority: TaskPriority
+            ) -> Int
+        {
+            return activityIndex * _priorityCount + priority.rawValue
+        }
+        
+        private func _enqueue(_ task: _Task) {
+            if let key = task.coalescingKey {
+                // Tasks shared with schedulers of other modes might have
+                // been executed there.
+                if let pendingTask = _coalescableTasks[key],
+                    !pendingTask.isExecuted
+                {
+                    pendingTask.coalesce(task)
+                    return
+                }
+                _coalescableTasks[key] = task
+            }
+            
+            for (activityIndex, activity) in _Scheduler._activities.enumerated()
+                where task.expectedActivities.contains(activity)
+            {
+                _buckets[
+                    _Scheduler._bucketIndex(
+                        activityIndex: activityIndex,
+                        priority: task.priority
+                    )
+                    ].append(task)
+            }
+        }
+        
         private func _runTasks(activity: CFRunLoopActivity) {
-            var removedIndices = [Int]()
+            _submissionQueue.popAll { _enqueue($0) }
             
-            for (index, task) in _tasks.enumerated() {
-                if !task.isExecuted {
-                    if !task.expectedActivities.isDisjoint(with: activity) {
+            guard let activityIndex = _Scheduler._activities.index(
+                where: { activity.contains($0) }
+                ) else
+            {
+                return
+            }
+            
+            let isAboutToWait = activityIndex == _Scheduler._beforeWaitingIndex
+            
+            let budget = _registry.taskTimeBudget
+            // Unlimited budgets need no clock reads.
+            let isBudgeted = budget < .infinity
+            let started = isBudgeted ? DispatchTime.now().uptimeNanoseconds : 0
+            var hasExecutedTasks = false
+            var hasDeferredTasks = false
+            
+            for rawPriority in stride(
+                from: TaskPriority.high.rawValue,
+                through: TaskPriority.low.rawValue,
+                by: -1
+                )
+            {
+                let priority = TaskPriority(rawValue: rawPriority)!
+                
+                let bucketIndex = _Scheduler._bucketIndex(
+                    activityIndex: activityIndex, priority: priority
+                )
+                
+                // Only visits the tasks in the bucket before this pass.
+                for _ in 0..<_buckets[bucketIndex].count {
+                    let task = _buckets[bucketIndex].removeFirst()
+                    
+                    if task.isExecuted {
+                        continue
+                    }
+                    
+                    // At least one task runs in each pass.
+                    if hasExecutedTasks && isBudgeted
+                        && TimeInterval(
+                            DispatchTime.now().uptimeNanoseconds - started
+                            ) / 1_000_000_000 + task.cost > budget
+                    {
+                        _buckets[bucketIndex].append(task)
+                        
+                        if !task.isDeferred {
+                            task.isDeferred = true
+                            
+                            if !isAboutToWait && !task.expectedActivities
+                                .contains(.beforeWaiting)
+                            {
+                                _buckets[
+                                    _Scheduler._bucketIndex(
+                                        activityIndex:
+                                        _Scheduler._beforeWaitingIndex,
+                                        priority: priority
+                                    )
+                                    ].append(task)
+                            }
+                        }
+                        
+                        hasDeferredTasks = true
+                    } else {
+                        if let key = task.coalescingKey {
+                            _coalescableTasks.removeValue(forKey: key)
+                        }
                         task.execute()
+                        hasExecutedTasks = true
                     }
                 }
-                
-                if task.isExecuted {
-                    removedIndices.append(index)
-                }
             }
             
-            _tasks.remove(indices: removedIndices)
+            // Keeps the run-loop from sleeping on deferred tasks.
+            if hasDeferredTasks {
+                CFRunLoopWakeUp(_cfRunLoop)
+            }
         }
         
         private static let _handleRunLoopActivity: CFRunLoopObserverCallBack = {
@@ -246,7 +749,13 @@ extension RunLoop {
             
             let unretainedSelf = aSelf.takeUnretainedValue()
             
-            for (_, scheduler) in unretainedSelf._schedulers {
+            let registry = objc_getAssociatedObject(
+                unretainedSelf, &schedulersKey
+                ) as? _SchedulerRegistry
+            
+            let schedulers = registry?.schedulers ?? [:]
+            
+            for (_, scheduler) in schedulers {
                 scheduler.invalidate()
             }
             
@@ -289,3 +798,7 @@ extension CFRunLoopMode {
 // MARK: - Constants
 private var schedulersKey =
 "com.WeZZard.Nest.RunLoop.TaskDispatcher._schedulers"
+
+private let _schedulersQueue = DispatchQueue(
+    label: "com.WeZZard.Nest.RunLoop.TaskDispatcher.Schedulers"
+)
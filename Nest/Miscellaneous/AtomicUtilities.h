@@ -0,0 +1,37 @@
+//
+//  AtomicUtilities.h
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+#ifndef AtomicUtilities_h
+#define AtomicUtilities_h
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+/// C11 atomic operations on pointer-sized storage for Swift, which cannot
+/// declare `_Atomic` storage itself. The storage shall only be accessed
+/// through these functions.
+
+static inline void * _Nullable _NestAtomicLoadPointer(void * _Nullable * _Nonnull storage) {
+    return atomic_load_explicit((void * _Atomic *)storage, memory_order_acquire);
+}
+
+static inline void _NestAtomicStorePointer(void * _Nullable * _Nonnull storage, void * _Nullable value) {
+    atomic_store_explicit((void * _Atomic *)storage, value, memory_order_release);
+}
+
+static inline void * _Nullable _NestAtomicExchangePointer(void * _Nullable * _Nonnull storage, void * _Nullable value) {
+    return atomic_exchange_explicit((void * _Atomic *)storage, value, memory_order_acq_rel);
+}
+
+/// Stores `desired` if `storage` holds `* expected`, or loads the held
+/// value into `* expected` otherwise.
+static inline bool _NestAtomicCompareAndSwapPointer(void * _Nullable * _Nonnull storage, void * _Nullable * _Nonnull expected, void * _Nullable desired) {
+    return atomic_compare_exchange_weak_explicit((void * _Atomic *)storage, expected, desired, memory_order_release, memory_order_relaxed);
+}
+
+#endif /* AtomicUtilities_h */
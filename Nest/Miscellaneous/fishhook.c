@@ -21,15 +21,58 @@
 // OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
-#import "fishhook.h"
+#if defined(__ELF__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // For dl_iterate_phdr and RTLD_DEFAULT.
+#endif
+
+#include "fishhook.h"
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
 
-#import <dlfcn.h>
-#import <stdlib.h>
-#import <string.h>
-#import <sys/types.h>
+#ifdef __ELF__
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#import <dispatch/dispatch.h>
+#import <pthread.h>
 #import <mach-o/dyld.h>
 #import <mach-o/loader.h>
 #import <mach-o/nlist.h>
+#endif
+
+#ifdef __ELF__
+
+#ifdef __LP64__
+#define ELF_R_SYM ELF64_R_SYM
+#define ELF_R_TYPE ELF64_R_TYPE
+#else
+#define ELF_R_SYM ELF32_R_SYM
+#define ELF_R_TYPE ELF32_R_TYPE
+#endif
+
+#if defined(__x86_64__)
+#define R_JUMP_SLOT R_X86_64_JUMP_SLOT
+#define R_GLOB_DAT  R_X86_64_GLOB_DAT
+#elif defined(__i386__)
+#define R_JUMP_SLOT R_386_JMP_SLOT
+#define R_GLOB_DAT  R_386_GLOB_DAT
+#elif defined(__aarch64__)
+#define R_JUMP_SLOT R_AARCH64_JUMP_SLOT
+#define R_GLOB_DAT  R_AARCH64_GLOB_DAT
+#elif defined(__arm__)
+#define R_JUMP_SLOT R_ARM_JUMP_SLOT
+#define R_GLOB_DAT  R_ARM_GLOB_DAT
+#else
+#error "fishhook: unsupported ELF architecture."
+#endif
+
+#else
 
 #ifdef __LP64__
 typedef struct mach_header_64 mach_header_t;
@@ -49,34 +92,423 @@ typedef struct nlist nlist_t;
 #define SEG_DATA_CONST  "__DATA_CONST"
 #endif
 
-struct rebindings_entry {
-  struct rebinding *rebindings;
-  size_t rebindings_nel;
-  struct rebindings_entry *next;
+// Images are processed concurrently when a rebinding is added to at least
+// this many loaded images.
+#define PARALLEL_IMAGE_COUNT_THRESHOLD 32
+
+#endif
+
+// An open addressing hash set of rebindings keyed by symbol name. Symbols
+// whose first byte or length no rebinding has are rejected before hashing
+// completes, so matching a symbol costs O(1) regardless of the number of
+// rebindings.
+struct rebindings_slot {
+  const char *name;
+  size_t name_len;
+  uint32_t hash;
+  void *replacement;
+  void **replaced;
 };
 
-static struct rebindings_entry *_rebindings_head;
+struct rebindings_table {
+  struct rebindings_slot *slots;
+  size_t capacity; // Zero or a power of two.
+  size_t count;
+  size_t min_name_len;
+  size_t max_name_len;
+  uint8_t first_bytes[32]; // A bitmap of the first bytes of names.
+};
+
+// FNV-1a. Stops after max_len + 1 bytes, in which case *len exceeds
+// max_len.
+static uint32_t hash_symbol_name(const char *name, size_t max_len, size_t *len) {
+  uint32_t hash = 2166136261u;
+  size_t i = 0;
+  for (; name[i] != '\0' && i <= max_len; i++) {
+    hash ^= (uint8_t)name[i];
+    hash *= 16777619u;
+  }
+  *len = i;
+  return hash;
+}
+
+static struct rebindings_slot *rebindings_table_probe(const struct rebindings_table *table,
+                                                      const char *name,
+                                                      size_t name_len,
+                                                      uint32_t hash) {
+  size_t mask = table->capacity - 1;
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    struct rebindings_slot *slot = &table->slots[i];
+    if (slot->name == NULL) {
+      return slot;
+    }
+    if (slot->hash == hash && slot->name_len == name_len &&
+        memcmp(slot->name, name, name_len) == 0) {
+      return slot;
+    }
+  }
+}
 
-static int prepend_rebindings(struct rebindings_entry **rebindings_head,
-                              struct rebinding rebindings[],
-                              size_t nel) {
-  struct rebindings_entry *new_entry = malloc(sizeof(struct rebindings_entry));
-  if (!new_entry) {
+static int rebindings_table_grow(struct rebindings_table *table) {
+  size_t capacity = table->capacity ? table->capacity * 2 : 16;
+  struct rebindings_slot *slots = calloc(capacity, sizeof(struct rebindings_slot));
+  if (!slots) {
     return -1;
   }
-  new_entry->rebindings = malloc(sizeof(struct rebinding) * nel);
-  if (!new_entry->rebindings) {
-    free(new_entry);
+  struct rebindings_table grown = *table;
+  grown.slots = slots;
+  grown.capacity = capacity;
+  for (size_t i = 0; i < table->capacity; i++) {
+    struct rebindings_slot *slot = &table->slots[i];
+    if (slot->name != NULL) {
+      *rebindings_table_probe(&grown, slot->name, slot->name_len, slot->hash) = *slot;
+    }
+  }
+  free(table->slots);
+  *table = grown;
+  return 0;
+}
+
+// A later rebinding of a symbol takes precedence.
+static int rebindings_table_insert(struct rebindings_table *table,
+                                   struct rebinding rebindings[],
+                                   size_t nel) {
+  for (size_t i = 0; i < nel; i++) {
+    const char *name = rebindings[i].name;
+    if ((table->count + 1) * 2 > table->capacity &&
+        rebindings_table_grow(table) < 0) {
+      return -1;
+    }
+    size_t name_len;
+    uint32_t hash = hash_symbol_name(name, SIZE_MAX - 1, &name_len);
+    struct rebindings_slot *slot = rebindings_table_probe(table, name, name_len, hash);
+    if (slot->name == NULL) {
+      slot->name = name;
+      slot->name_len = name_len;
+      slot->hash = hash;
+      table->count++;
+      if (table->count == 1 || name_len < table->min_name_len) {
+        table->min_name_len = name_len;
+      }
+      if (name_len > table->max_name_len) {
+        table->max_name_len = name_len;
+      }
+      table->first_bytes[(uint8_t)name[0] >> 3] |= 1 << ((uint8_t)name[0] & 7);
+    }
+    slot->replacement = rebindings[i].replacement;
+    slot->replaced = rebindings[i].replaced;
+  }
+  return 0;
+}
+
+static const struct rebindings_slot *rebindings_table_lookup(const struct rebindings_table *table,
+                                                             const char *symbol_name) {
+  uint8_t first_byte = (uint8_t)symbol_name[0];
+  if (table->count == 0 ||
+      (table->first_bytes[first_byte >> 3] & (1 << (first_byte & 7))) == 0) {
+    return NULL;
+  }
+  size_t name_len;
+  uint32_t hash = hash_symbol_name(symbol_name, table->max_name_len, &name_len);
+  if (name_len < table->min_name_len || name_len > table->max_name_len) {
+    return NULL;
+  }
+  const struct rebindings_slot *slot = rebindings_table_probe(table, symbol_name, name_len, hash);
+  return slot->name != NULL ? slot : NULL;
+}
+
+static void rebindings_table_free(struct rebindings_table *table) {
+  free(table->slots);
+  memset(table, 0, sizeof(struct rebindings_table));
+}
+
+#ifdef __ELF__
+
+struct elf_image {
+  const struct dl_phdr_info *info;
+  const ElfW(Sym) *symtab;
+  const char *strtab;
+  ElfW(Addr) relro_start;
+  ElfW(Addr) relro_end;
+  // The ranges of .plt and .plt.sec, read from the file on first use.
+  int are_plt_ranges_loaded;
+  ElfW(Addr) plt_ranges[2][2];
+};
+
+// Section headers aren't loaded, so they are read from the file of the
+// image. Images without a readable file, such as the vDSO, have no ranges.
+static void elf_image_load_plt_ranges(struct elf_image *image) {
+  image->are_plt_ranges_loaded = 1;
+  const char *path = image->info->dlpi_name;
+  if (path == NULL || path[0] == '\0') {
+    path = "/proc/self/exe";
+  }
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  ElfW(Shdr) *shdrs = NULL;
+  char *shstrtab = NULL;
+  ElfW(Ehdr) ehdr;
+  if (pread(fd, &ehdr, sizeof(ehdr), 0) != sizeof(ehdr) ||
+      memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+      ehdr.e_shentsize != sizeof(ElfW(Shdr)) ||
+      ehdr.e_shnum == 0 || ehdr.e_shstrndx >= ehdr.e_shnum) {
+    goto done;
+  }
+  size_t shdrs_size = ehdr.e_shnum * sizeof(ElfW(Shdr));
+  shdrs = malloc(shdrs_size);
+  if (!shdrs || pread(fd, shdrs, shdrs_size, (off_t)ehdr.e_shoff) != (ssize_t)shdrs_size) {
+    goto done;
+  }
+  const ElfW(Shdr) *shstrtab_shdr = &shdrs[ehdr.e_shstrndx];
+  shstrtab = malloc(shstrtab_shdr->sh_size + 1);
+  if (!shstrtab ||
+      pread(fd, shstrtab, shstrtab_shdr->sh_size, (off_t)shstrtab_shdr->sh_offset) !=
+        (ssize_t)shstrtab_shdr->sh_size) {
+    goto done;
+  }
+  shstrtab[shstrtab_shdr->sh_size] = '\0';
+  for (ElfW(Half) i = 0; i < ehdr.e_shnum; i++) {
+    if (shdrs[i].sh_name >= shstrtab_shdr->sh_size) {
+      continue;
+    }
+    const char *name = shstrtab + shdrs[i].sh_name;
+    int index = strcmp(name, ".plt") == 0 ? 0 : strcmp(name, ".plt.sec") == 0 ? 1 : -1;
+    if (index >= 0) {
+      image->plt_ranges[index][0] = image->info->dlpi_addr + shdrs[i].sh_addr;
+      image->plt_ranges[index][1] = image->plt_ranges[index][0] + shdrs[i].sh_size;
+    }
+  }
+done:
+  free(shstrtab);
+  free(shdrs);
+  close(fd);
+}
+
+// Whether a slot still points to a PLT stub of the image, which means it
+// is lazily bound and hasn't been resolved yet. A slot pointing elsewhere
+// in the image, such as to an earlier replacement, is bound.
+static int elf_image_plt_contains(struct elf_image *image, ElfW(Addr) address) {
+  if (!image->are_plt_ranges_loaded) {
+    elf_image_load_plt_ranges(image);
+  }
+  for (int i = 0; i < 2; i++) {
+    if (address >= image->plt_ranges[i][0] && address < image->plt_ranges[i][1]) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void perform_rebinding_with_relocation(const struct rebindings_table *rebindings,
+                                              struct elf_image *image,
+                                              ElfW(Addr) offset,
+                                              uintptr_t info) {
+  uintptr_t type = ELF_R_TYPE(info);
+  if (type != R_JUMP_SLOT && type != R_GLOB_DAT) {
+    return;
+  }
+  const char *symbol_name = image->strtab + image->symtab[ELF_R_SYM(info)].st_name;
+  if (symbol_name[0] == '\0') {
+    return;
+  }
+  const struct rebindings_slot *slot = rebindings_table_lookup(rebindings, symbol_name);
+  if (!slot) {
+    return;
+  }
+  ElfW(Addr) address = image->info->dlpi_addr + offset;
+  void **binding = (void **)address;
+  if (*binding == slot->replacement) {
+    return;
+  }
+  if (slot->replaced != NULL) {
+    // A lazily bound slot still points to the PLT of the image, and the
+    // resolver would overwrite the replacement when called.
+    if (elf_image_plt_contains(image, (ElfW(Addr))*binding)) {
+      *(slot->replaced) = dlsym(RTLD_DEFAULT, symbol_name);
+    } else {
+      *(slot->replaced) = *binding;
+    }
+  }
+  // The GOT is read-only after relocation when linked with RELRO.
+  int is_relro = address >= image->relro_start && address < image->relro_end;
+  uintptr_t page_size = (uintptr_t)sysconf(_SC_PAGESIZE);
+  void *page = (void *)(address & ~(page_size - 1));
+  if (is_relro && mprotect(page, page_size, PROT_READ | PROT_WRITE) != 0) {
+    return;
+  }
+  *binding = slot->replacement;
+  if (is_relro) {
+    mprotect(page, page_size, PROT_READ);
+  }
+}
+
+struct rebind_symbols_for_image_context {
+  const struct rebindings_table *rebindings;
+  const void *header; // NULL for all images.
+};
+
+static int rebind_symbols_for_image(struct dl_phdr_info *info, size_t size, void *data) {
+  (void)size;
+  struct rebind_symbols_for_image_context *context = data;
+  const ElfW(Dyn) *dynamic = NULL;
+  struct elf_image image = { info, NULL, NULL, 0, 0, 0, { { 0, 0 }, { 0, 0 } } };
+  int matches_header = context->header == NULL ||
+                       context->header == (const void *)info->dlpi_addr;
+
+  for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+    const ElfW(Phdr) *phdr = &info->dlpi_phdr[i];
+    if (phdr->p_type == PT_DYNAMIC) {
+      dynamic = (const ElfW(Dyn) *)(info->dlpi_addr + phdr->p_vaddr);
+    } else if (phdr->p_type == PT_GNU_RELRO) {
+      image.relro_start = info->dlpi_addr + phdr->p_vaddr;
+      image.relro_end = image.relro_start + phdr->p_memsz;
+    } else if (phdr->p_type == PT_LOAD && phdr->p_offset == 0 &&
+               context->header == (const void *)(info->dlpi_addr + phdr->p_vaddr)) {
+      matches_header = 1;
+    }
+  }
+
+  if (!matches_header || !dynamic) {
+    return 0;
+  }
+
+  ElfW(Addr) jmprel = 0, rela = 0, rel = 0;
+  size_t pltrelsz = 0, relasz = 0, relsz = 0;
+  ElfW(Sxword) pltrel = DT_RELA;
+  for (const ElfW(Dyn) *dyn = dynamic; dyn->d_tag != DT_NULL; dyn++) {
+    // Some loaders leave the addresses in the dynamic section unrelocated.
+    ElfW(Addr) ptr = dyn->d_un.d_ptr;
+    if (ptr < info->dlpi_addr) {
+      ptr += info->dlpi_addr;
+    }
+    switch (dyn->d_tag) {
+      case DT_SYMTAB: image.symtab = (const ElfW(Sym) *)ptr; break;
+      case DT_STRTAB: image.strtab = (const char *)ptr; break;
+      case DT_JMPREL: jmprel = ptr; break;
+      case DT_PLTRELSZ: pltrelsz = dyn->d_un.d_val; break;
+      case DT_PLTREL: pltrel = (ElfW(Sxword))dyn->d_un.d_val; break;
+      case DT_RELA: rela = ptr; break;
+      case DT_RELASZ: relasz = dyn->d_un.d_val; break;
+      case DT_REL: rel = ptr; break;
+      case DT_RELSZ: relsz = dyn->d_un.d_val; break;
+      default: break;
+    }
+  }
+
+  if (!image.symtab || !image.strtab) {
+    return 0;
+  }
+
+  if (jmprel && pltrel == DT_RELA) {
+    const ElfW(Rela) *relocations = (const ElfW(Rela) *)jmprel;
+    for (size_t i = 0; i < pltrelsz / sizeof(ElfW(Rela)); i++) {
+      perform_rebinding_with_relocation(context->rebindings, &image,
+                                        relocations[i].r_offset, relocations[i].r_info);
+    }
+  } else if (jmprel) {
+    const ElfW(Rel) *relocations = (const ElfW(Rel) *)jmprel;
+    for (size_t i = 0; i < pltrelsz / sizeof(ElfW(Rel)); i++) {
+      perform_rebinding_with_relocation(context->rebindings, &image,
+                                        relocations[i].r_offset, relocations[i].r_info);
+    }
+  }
+  if (rela) {
+    const ElfW(Rela) *relocations = (const ElfW(Rela) *)rela;
+    for (size_t i = 0; i < relasz / sizeof(ElfW(Rela)); i++) {
+      perform_rebinding_with_relocation(context->rebindings, &image,
+                                        relocations[i].r_offset, relocations[i].r_info);
+    }
+  }
+  if (rel) {
+    const ElfW(Rel) *relocations = (const ElfW(Rel) *)rel;
+    for (size_t i = 0; i < relsz / sizeof(ElfW(Rel)); i++) {
+      perform_rebinding_with_relocation(context->rebindings, &image,
+                                        relocations[i].r_offset, relocations[i].r_info);
+    }
+  }
+
+  return context->header != NULL;
+}
+
+int rebind_symbols_image(void *header,
+                         intptr_t slide,
+                         struct rebinding rebindings[],
+                         size_t rebindings_nel) {
+    (void)slide;
+    struct rebindings_table table = { 0 };
+    if (rebindings_table_insert(&table, rebindings, rebindings_nel) < 0) {
+      rebindings_table_free(&table);
+      return -1;
+    }
+    struct rebind_symbols_for_image_context context = { &table, header };
+    dl_iterate_phdr(rebind_symbols_for_image, &context);
+    rebindings_table_free(&table);
+    return 0;
+}
+
+int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel) {
+  struct rebindings_table added = { 0 };
+  int retval = rebindings_table_insert(&added, rebindings, rebindings_nel);
+  if (retval < 0) {
+    rebindings_table_free(&added);
+    return retval;
+  }
+  // There is no notification of image additions, so only loaded images are
+  // rebound.
+  struct rebind_symbols_for_image_context context = { &added, NULL };
+  dl_iterate_phdr(rebind_symbols_for_image, &context);
+  rebindings_table_free(&added);
+  return retval;
+}
+
+#else
+
+// Rebindings applied to images loaded later.
+static struct rebindings_table _rebindings_table;
+static pthread_mutex_t _rebindings_table_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Merges rebindings into the process-wide table, and also builds a table
+// of them alone in added, so that loaded images are only searched for the
+// new symbols.
+//
+// When resolves_replaced is set, the originals are stored to replaced here,
+// once, and added doesn't write them: the replacement of an earlier
+// rebinding of the symbol, or else the symbol dlsym finds. Images rebound
+// in parallel would otherwise race to store theirs.
+static int add_rebindings(struct rebindings_table *added,
+                          struct rebinding rebindings[],
+                          size_t nel,
+                          int resolves_replaced) {
+  pthread_mutex_lock(&_rebindings_table_lock);
+  if (resolves_replaced) {
+    for (size_t i = 0; i < nel; i++) {
+      if (rebindings[i].replaced == NULL) {
+        continue;
+      }
+      const struct rebindings_slot *slot =
+        rebindings_table_lookup(&_rebindings_table, rebindings[i].name);
+      *(rebindings[i].replaced) = slot != NULL
+        ? slot->replacement
+        : dlsym(RTLD_DEFAULT, rebindings[i].name);
+    }
+  }
+  int retval = rebindings_table_insert(&_rebindings_table, rebindings, nel);
+  pthread_mutex_unlock(&_rebindings_table_lock);
+  if (retval < 0 || rebindings_table_insert(added, rebindings, nel) < 0) {
+    rebindings_table_free(added);
     return -1;
   }
-  memcpy(new_entry->rebindings, rebindings, sizeof(struct rebinding) * nel);
-  new_entry->rebindings_nel = nel;
-  new_entry->next = *rebindings_head;
-  *rebindings_head = new_entry;
+  if (resolves_replaced) {
+    for (size_t i = 0; i < added->capacity; i++) {
+      added->slots[i].replaced = NULL;
+    }
+  }
   return 0;
 }
 
-static void perform_rebinding_with_section(struct rebindings_entry *rebindings,
+static void perform_rebinding_with_section(const struct rebindings_table *rebindings,
                                            section_t *section,
                                            intptr_t slide,
                                            nlist_t *symtab,
@@ -92,32 +524,27 @@ static void perform_rebinding_with_section(struct rebindings_entry *rebindings,
     }
     uint32_t strtab_offset = symtab[symtab_index].n_un.n_strx;
     char *symbol_name = strtab + strtab_offset;
-    if (strnlen(symbol_name, 2) < 2) {
+    if (symbol_name[0] == '\0' || symbol_name[1] == '\0') {
       continue;
     }
-    struct rebindings_entry *cur = rebindings;
-    while (cur) {
-      for (uint j = 0; j < cur->rebindings_nel; j++) {
-        if (strcmp(&symbol_name[1], cur->rebindings[j].name) == 0) {
-          if (cur->rebindings[j].replaced != NULL &&
-              indirect_symbol_bindings[i] != cur->rebindings[j].replacement) {
-            *(cur->rebindings[j].replaced) = indirect_symbol_bindings[i];
-          }
-          indirect_symbol_bindings[i] = cur->rebindings[j].replacement;
-          goto symbol_loop;
-        }
-      }
-      cur = cur->next;
+    // Skip the leading underscore of C symbols.
+    const struct rebindings_slot *slot = rebindings_table_lookup(rebindings, &symbol_name[1]);
+    if (!slot) {
+      continue;
+    }
+    if (slot->replaced != NULL &&
+        indirect_symbol_bindings[i] != slot->replacement) {
+      *(slot->replaced) = indirect_symbol_bindings[i];
     }
-  symbol_loop:;
+    indirect_symbol_bindings[i] = slot->replacement;
   }
 }
 
-static void rebind_symbols_for_image(struct rebindings_entry *rebindings,
+static void rebind_symbols_for_image(const struct rebindings_table *rebindings,
                                      const struct mach_header *header,
                                      intptr_t slide) {
   Dl_info info;
-  if (dladdr(header, &info) == 0) {
+  if (header == NULL || dladdr(header, &info) == 0) {
     return;
   }
 
@@ -177,34 +604,60 @@ static void rebind_symbols_for_image(struct rebindings_entry *rebindings,
 
 static void _rebind_symbols_for_image(const struct mach_header *header,
                                       intptr_t slide) {
-    rebind_symbols_for_image(_rebindings_head, header, slide);
+    pthread_mutex_lock(&_rebindings_table_lock);
+    rebind_symbols_for_image(&_rebindings_table, header, slide);
+    pthread_mutex_unlock(&_rebindings_table_lock);
+}
+
+static void rebind_symbols_for_image_at_index(void *context, size_t index) {
+  const struct rebindings_table *rebindings = context;
+  rebind_symbols_for_image(rebindings,
+                           _dyld_get_image_header((uint32_t)index),
+                           _dyld_get_image_vmaddr_slide((uint32_t)index));
 }
 
 int rebind_symbols_image(void *header,
                          intptr_t slide,
                          struct rebinding rebindings[],
                          size_t rebindings_nel) {
-    struct rebindings_entry *rebindings_head = NULL;
-    int retval = prepend_rebindings(&rebindings_head, rebindings, rebindings_nel);
-    rebind_symbols_for_image(rebindings_head, header, slide);
-    free(rebindings_head);
+    struct rebindings_table table = { 0 };
+    int retval = rebindings_table_insert(&table, rebindings, rebindings_nel);
+    if (retval == 0) {
+      rebind_symbols_for_image(&table, header, slide);
+    }
+    rebindings_table_free(&table);
     return retval;
 }
 
 int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel) {
-  int retval = prepend_rebindings(&_rebindings_head, rebindings, rebindings_nel);
+  pthread_mutex_lock(&_rebindings_table_lock);
+  int is_first_call = _rebindings_table.count == 0;
+  pthread_mutex_unlock(&_rebindings_table_lock);
+  uint32_t c = is_first_call ? 0 : _dyld_image_count();
+  int is_parallel = c >= PARALLEL_IMAGE_COUNT_THRESHOLD;
+  struct rebindings_table added = { 0 };
+  int retval = add_rebindings(&added, rebindings, rebindings_nel, is_parallel);
   if (retval < 0) {
     return retval;
   }
   // If this was the first call, register callback for image additions (which is also invoked for
-  // existing images, otherwise, just run on existing images
-  if (!_rebindings_head->next) {
+  // existing images, otherwise, just run on existing images with the added rebindings
+  if (is_first_call) {
     _dyld_register_func_for_add_image(_rebind_symbols_for_image);
   } else {
-    uint32_t c = _dyld_image_count();
-    for (uint32_t i = 0; i < c; i++) {
-      _rebind_symbols_for_image(_dyld_get_image_header(i), _dyld_get_image_vmaddr_slide(i));
+    if (is_parallel) {
+      // Images don't share bindings, and add_rebindings has already stored
+      // the originals to replaced.
+      dispatch_apply_f(c, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0),
+                       &added, rebind_symbols_for_image_at_index);
+    } else {
+      for (uint32_t i = 0; i < c; i++) {
+        rebind_symbols_for_image_at_index(&added, i);
+      }
     }
   }
+  rebindings_table_free(&added);
   return retval;
 }
+
+#endif
@@ -54,6 +54,9 @@ struct rebinding {
  * by the process. If rebind_functions is called more than once, the symbols to
  * rebind are added to the existing list of rebindings, and if a given symbol
  * is rebound more than once, the later rebinding will take precedence.
+ *
+ * On ELF platforms, GOT/PLT entries of the objects loaded at the time of the
+ * call are rebound. Objects loaded later are not.
  */
 FISHHOOK_VISIBILITY
 int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel);
@@ -61,6 +64,9 @@ int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel);
 /*
  * Rebinds as above, but only in the specified image. The header should point
  * to the mach-o header, the slide should be the slide offset. Others as above.
+ *
+ * On ELF platforms, the header should point to the ELF header of the object
+ * or be its load address, and the slide is ignored.
  */
 FISHHOOK_VISIBILITY
 int rebind_symbols_image(void *header,
@@ -0,0 +1,19 @@
+//
+//  AllocationCounting.h
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Returns the number of allocations made by the default malloc zone of
+/// the process while `block` runs, counting `malloc`, `calloc`, `valloc`,
+/// `realloc` and `memalign`.
+FOUNDATION_EXTERN uint64_t AllocationCountOfBlock(void (NS_NOESCAPE ^ block)(void))
+    NS_SWIFT_NAME(allocationCount(of:));
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,99 @@
+//
+//  AllocationCounting.m
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+#import "AllocationCounting.h"
+
+#import <malloc/malloc.h>
+#import <mach/mach.h>
+#import <stdatomic.h>
+
+static _Atomic(uint64_t) _allocationCount;
+
+static malloc_zone_t _originalZone;
+
+static void * _AllocationCountingMalloc(malloc_zone_t * zone, size_t size) {
+    atomic_fetch_add_explicit(&_allocationCount, 1, memory_order_relaxed);
+    return _originalZone.malloc(zone, size);
+}
+
+static void * _AllocationCountingCalloc(malloc_zone_t * zone, size_t count, size_t size) {
+    atomic_fetch_add_explicit(&_allocationCount, 1, memory_order_relaxed);
+    return _originalZone.calloc(zone, count, size);
+}
+
+static void * _AllocationCountingValloc(malloc_zone_t * zone, size_t size) {
+    atomic_fetch_add_explicit(&_allocationCount, 1, memory_order_relaxed);
+    return _originalZone.valloc(zone, size);
+}
+
+static void * _AllocationCountingRealloc(malloc_zone_t * zone, void * pointer, size_t size) {
+    atomic_fetch_add_explicit(&_allocationCount, 1, memory_order_relaxed);
+    return _originalZone.realloc(zone, pointer, size);
+}
+
+static void * _AllocationCountingMemalign(malloc_zone_t * zone, size_t alignment, size_t size) {
+    atomic_fetch_add_explicit(&_allocationCount, 1, memory_order_relaxed);
+    return _originalZone.memalign(zone, alignment, size);
+}
+
+/// Replaces the allocation functions of `zone`. The default zone may live
+/// in read-only memory, so the protection is lifted for the replacement
+/// and restored after it.
+static void _AllocationCountingSetZoneFunctions(malloc_zone_t * zone, const malloc_zone_t * functions) {
+    vm_address_t address = (vm_address_t)zone;
+    vm_size_t size = 0;
+    vm_region_basic_info_data_64_t info;
+    mach_msg_type_number_t infoCount = VM_REGION_BASIC_INFO_COUNT_64;
+    mach_port_t objectName = MACH_PORT_NULL;
+    
+    kern_return_t result = vm_region_64(mach_task_self(), &address, &size, VM_REGION_BASIC_INFO_64, (vm_region_info_t)&info, &infoCount, &objectName);
+    NSCAssert(result == KERN_SUCCESS, @"Cannot inspect the memory of the default malloc zone.");
+    
+    vm_address_t page = trunc_page((vm_address_t)zone);
+    vm_size_t length = round_page((vm_address_t)zone + sizeof(malloc_zone_t)) - page;
+    
+    BOOL isWritable = (info.protection & VM_PROT_WRITE) != 0;
+    
+    if (!isWritable) {
+        result = vm_protect(mach_task_self(), page, length, 0, VM_PROT_READ | VM_PROT_WRITE);
+        NSCAssert(result == KERN_SUCCESS, @"Cannot make the default malloc zone writable.");
+    }
+    
+    zone->malloc = functions->malloc;
+    zone->calloc = functions->calloc;
+    zone->valloc = functions->valloc;
+    zone->realloc = functions->realloc;
+    if (zone->version >= 5) {
+        zone->memalign = functions->memalign;
+    }
+    
+    if (!isWritable) {
+        vm_protect(mach_task_self(), page, length, 0, info.protection);
+    }
+}
+
+uint64_t AllocationCountOfBlock(void (NS_NOESCAPE ^ block)(void)) {
+    malloc_zone_t * zone = malloc_default_zone();
+    
+    _originalZone = *zone;
+    
+    malloc_zone_t countingZone = *zone;
+    countingZone.malloc = &_AllocationCountingMalloc;
+    countingZone.calloc = &_AllocationCountingCalloc;
+    countingZone.valloc = &_AllocationCountingValloc;
+    countingZone.realloc = &_AllocationCountingRealloc;
+    countingZone.memalign = &_AllocationCountingMemalign;
+    
+    atomic_store(&_allocationCount, 0);
+    
+    _AllocationCountingSetZoneFunctions(zone, &countingZone);
+    block();
+    _AllocationCountingSetZoneFunctions(zone, &_originalZone);
+    
+    return atomic_load(&_allocationCount);
+}
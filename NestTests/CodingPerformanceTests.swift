@@ -0,0 +1,701 @@
+//
+//  CodingPerformanceTests.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import XCTest
+import Foundation
+import Nest
+
+import CoreGraphics
+#if os(iOS) || os(tvOS)
+    import UIKit
+#elseif os(OSX)
+    import AppKit
+#endif
+
+private let objectCount = 1000
+
+/// Compares the coding paths of Nest for representative model shapes:
+///
+/// - Plain: hand written `NSCoding` with `NSKeyedArchiver`'s API.
+/// - Normalized: `NSCoder+InterfaceNormalization` and `ObjCNormalizedCoding`.
+/// - Dynamic: `ObjCDynamicCoder` with the `ObjCDynamicCoding` call-backs.
+/// - Columnar: `ObjCDynamicCoder`'s columnar coding.
+///
+/// Throughputs are reported by `measure`. Archive sizes and allocations
+/// per decoded object are attached to the decoding tests.
+///
+/// The suite runs headless with `xcodebuild test`. There is no Linux or
+/// GNUstep target for it: `ObjCDynamicCoder` and the models here rely on
+/// Swift's Objective-C interoperability (`@objc`, `@NSManaged` and
+/// runtime synthesized dynamic properties), which Swift on Linux doesn't
+/// provide. The ELF backend of `fishhook` doesn't change that.
+class CodingPerformanceTests: XCTestCase {
+    // MARK: Scalar Heavy
+    func testScalarHeavyPlainEncoding() {
+        measureEncoding(_PlainScalarHeavyModel.samples())
+    }
+    
+    func testScalarHeavyPlainDecoding() {
+        measureDecoding(_PlainScalarHeavyModel.samples(), "scalar-heavy plain")
+    }
+    
+    func testScalarHeavyNormalizedEncoding() {
+        measureEncoding(_NormalizedScalarHeavyModel.samples())
+    }
+    
+    func testScalarHeavyNormalizedDecoding() {
+        measureDecoding(
+            _NormalizedScalarHeavyModel.samples(), "scalar-heavy normalized"
+        )
+    }
+    
+    func testScalarHeavyDynamicEncoding() {
+        measureEncoding(_DynamicScalarHeavyModel.samples())
+    }
+    
+    func testScalarHeavyDynamicDecoding() {
+        measureDecoding(
+            _DynamicScalarHeavyModel.samples(), "scalar-heavy dynamic"
+        )
+    }
+    
+    func testScalarHeavyColumnarEncoding() {
+        measureColumnarEncoding(_DynamicScalarHeavyModel.samples())
+    }
+    
+    func testScalarHeavyColumnarDecoding() {
+        measureColumnarDecoding(
+            _DynamicScalarHeavyModel.samples(), "scalar-heavy columnar"
+        )
+    }
+    
+    // MARK: Struct Heavy
+    func testStructHeavyPlainEncoding() {
+        measureEncoding(_PlainStructHeavyModel.samples())
+    }
+    
+    func testStructHeavyPlainDecoding() {
+        measureDecoding(_PlainStructHeavyModel.samples(), "struct-heavy plain")
+    }
+    
+    func testStructHeavyNormalizedEncoding() {
+        measureEncoding(_NormalizedStructHeavyModel.samples())
+    }
+    
+    func testStructHeavyNormalizedDecoding() {
+        measureDecoding(
+            _NormalizedStructHeavyModel.samples(), "struct-heavy normalized"
+        )
+    }
+    
+    func testStructHeavyDynamicEncoding() {
+        measureEncoding(_DynamicStructHeavyModel.samples())
+    }
+    
+    func testStructHeavyDynamicDecoding() {
+        measureDecoding(
+            _DynamicStructHeavyModel.samples(), "struct-heavy dynamic"
+        )
+    }
+    
+    func testStructHeavyColumnarEncoding() {
+        measureColumnarEncoding(_DynamicStructHeavyModel.samples())
+    }
+    
+    func testStructHeavyColumnarDecoding() {
+        measureColumnarDecoding(
+            _DynamicStructHeavyModel.samples(), "struct-heavy columnar"
+        )
+    }
+    
+    // MARK: String Heavy
+    func testStringHeavyPlainEncoding() {
+        measureEncoding(_PlainStringHeavyModel.samples())
+    }
+    
+    func testStringHeavyPlainDecoding() {
+        measureDecoding(_PlainStringHeavyModel.samples(), "string-heavy plain")
+    }
+    
+    func testStringHeavyNormalizedEncoding() {
+        measureEncoding(_NormalizedStringHeavyModel.samples())
+    }
+    
+    func testStringHeavyNormalizedDecoding() {
+        measureDecoding(
+            _NormalizedStringHeavyModel.samples(), "string-heavy normalized"
+        )
+    }
+    
+    func testStringHeavyDynamicEncoding() {
+        measureEncoding(_DynamicStringHeavyModel.samples())
+    }
+    
+    func testStringHeavyDynamicDecoding() {
+        measureDecoding(
+            _DynamicStringHeavyModel.samples(), "string-heavy dynamic"
+        )
+    }
+    
+    func testStringHeavyColumnarEncoding() {
+        measureColumnarEncoding(_DynamicStringHeavyModel.samples())
+    }
+    
+    func testStringHeavyColumnarDecoding() {
+        measureColumnarDecoding(
+            _DynamicStringHeavyModel.samples(), "string-heavy columnar"
+        )
+    }
+    
+    // MARK: Nested
+    func testNestedPlainEncoding() {
+        measureEncoding(_PlainNestedModel.samples())
+    }
+    
+    func testNestedPlainDecoding() {
+        measureDecoding(_PlainNestedModel.samples(), "nested plain")
+    }
+    
+    func testNestedNormalizedEncoding() {
+        measureEncoding(_NormalizedNestedModel.samples())
+    }
+    
+    func testNestedNormalizedDecoding() {
+        measureDecoding(_NormalizedNestedModel.samples(), "nested normalized")
+    }
+    
+    func testNestedDynamicEncoding() {
+        measureEncoding(_DynamicNestedModel.samples())
+    }
+    
+    func testNestedDynamicDecoding() {
+        measureDecoding(_DynamicNestedModel.samples(), "nested dynamic")
+    }
+    
+    // MARK: Utilities
+    private func measureEncoding(_ objects: [NSObject]) {
+        measure {
+            _ = NSKeyedArchiver.archivedData(withRootObject: objects)
+        }
+    }
+    
+    private func measureDecoding(_ objects: [NSObject], _ name: String) {
+        let data = NSKeyedArchiver.archivedData(withRootObject: objects)
+        
+        report(name, data: data) {
+            NSKeyedUnarchiver.unarchiveObject(with: data) as? [NSObject]
+        }
+        
+        measure {
+            _ = NSKeyedUnarchiver.unarchiveObject(with: data)
+        }
+    }
+    
+    private func measureColumnarEncoding(_ objects: [ObjCDynamicCoder]) {
+        let objectClass: ObjCDynamicCoder.Type = type(of: objects[0])
+        
+        measure {
+            _ = archiveColumns(objects, of: objectClass)
+        }
+    }
+    
+    private func measureColumnarDecoding(
+        _ objects: [ObjCDynamicCoder], _ name: String
+        )
+    {
+        let objectClass: ObjCDynamicCoder.Type = type(of: objects[0])
+        
+        let data = archiveColumns(objects, of: objectClass)
+        
+        report(name, data: data) {
+            let unarchiver = NSKeyedUnarchiver(forReadingWith: data)
+            return objectClass.decodeObjects(with: unarchiver, forKey: "objects")
+        }
+        
+        measure {
+            let unarchiver = NSKeyedUnarchiver(forReadingWith: data)
+            _ = objectClass.decodeObjects(with: unarchiver, forKey: "objects")
+        }
+    }
+    
+    private func archiveColumns(
+        _ objects: [ObjCDynamicCoder], of objectClass: ObjCDynamicCoder.Type
+        ) -> Data
+    {
+        let data = NSMutableData()
+        let archiver = NSKeyedArchiver(forWritingWith: data)
+        objectClass.encodeObjects(objects, with: archiver, forKey: "objects")
+        archiver.finishEncoding()
+        return data as Data
+    }
+    
+    private func report(
+        _ name: String, data: Data, decode: () -> [NSObject]?
+        )
+    {
+        var decoded: [NSObject]?
+        let allocations = allocationCount {
+            decoded = decode()
+        }
+        
+        XCTAssert(decoded?.count == objectCount, name)
+        
+        let allocationsPerObject = Double(allocations) / Double(objectCount)
+        
+        let attachment = XCTAttachment(string: "\(name): \(data.count) bytes, \(data.count / objectCount) bytes/object, \(allocationsPerObject) allocations/object")
+        attachment.name = "Coding Benchmark"
+        attachment.lifetime = .keepAlways
+        add(attachment)
+        
+        withExtendedLifetime(decoded) {}
+    }
+}
+
+// MARK: - Scalar Heavy Models
+@objc(_PlainScalarHeavyModel)
+private final class _PlainScalarHeavyModel: NSObject, NSCoding {
+    var int8Value: Int8 = 0
+    var int16Value: Int16 = 0
+    var int32Value: Int32 = 0
+    var int64Value: Int64 = 0
+    var uint32Value: UInt32 = 0
+    var boolValue: Bool = false
+    var floatValue: Float = 0
+    var doubleValue: Double = 0
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map(sample)
+    }
+    
+    static func sample(at index: Int) -> _PlainScalarHeavyModel {
+        let model = _PlainScalarHeavyModel()
+        model.int8Value = Int8(truncatingBitPattern: index)
+        model.int16Value = Int16(index)
+        model.int32Value = Int32(index)
+        model.int64Value = Int64(index)
+        model.uint32Value = UInt32(index)
+        model.boolValue = index % 2 == 0
+        model.floatValue = Float(index) / 3
+        model.doubleValue = Double(index) / 7
+        return model
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        int8Value = Int8(aDecoder.decodeInt32(forKey: "int8Value"))
+        int16Value = Int16(aDecoder.decodeInt32(forKey: "int16Value"))
+        int32Value = aDecoder.decodeInt32(forKey: "int32Value")
+        int64Value = aDecoder.decodeInt64(forKey: "int64Value")
+        uint32Value = UInt32(aDecoder.decodeInt64(forKey: "uint32Value"))
+        boolValue = aDecoder.decodeBool(forKey: "boolValue")
+        floatValue = aDecoder.decodeFloat(forKey: "floatValue")
+        doubleValue = aDecoder.decodeDouble(forKey: "doubleValue")
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(Int32(int8Value), forKey: "int8Value")
+        aCoder.encode(Int32(int16Value), forKey: "int16Value")
+        aCoder.encode(int32Value, forKey: "int32Value")
+        aCoder.encode(int64Value, forKey: "int64Value")
+        aCoder.encode(Int64(uint32Value), forKey: "uint32Value")
+        aCoder.encode(boolValue, forKey: "boolValue")
+        aCoder.encode(floatValue, forKey: "floatValue")
+        aCoder.encode(doubleValue, forKey: "doubleValue")
+    }
+}
+
+@objc(_NormalizedScalarHeavyModel)
+private final class _NormalizedScalarHeavyModel: NSObject, NSCoding {
+    var int8Value: Int8 = 0
+    var int16Value: Int16 = 0
+    var int32Value: Int32 = 0
+    var int64Value: Int64 = 0
+    var uint32Value: UInt32 = 0
+    var boolValue: Bool = false
+    var floatValue: Float = 0
+    var doubleValue: Double = 0
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map(sample)
+    }
+    
+    static func sample(at index: Int) -> _NormalizedScalarHeavyModel {
+        let model = _NormalizedScalarHeavyModel()
+        model.int8Value = Int8(truncatingBitPattern: index)
+        model.int16Value = Int16(index)
+        model.int32Value = Int32(index)
+        model.int64Value = Int64(index)
+        model.uint32Value = UInt32(index)
+        model.boolValue = index % 2 == 0
+        model.floatValue = Float(index) / 3
+        model.doubleValue = Double(index) / 7
+        return model
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        do {
+            int8Value = try aDecoder.decodeOrThrow(for: "int8Value")
+            int16Value = try aDecoder.decodeOrThrow(for: "int16Value")
+            int32Value = try aDecoder.decodeOrThrow(for: "int32Value")
+            int64Value = try aDecoder.decodeOrThrow(for: "int64Value")
+            uint32Value = try aDecoder.decodeOrThrow(for: "uint32Value")
+            boolValue = try aDecoder.decodeOrThrow(for: "boolValue")
+            floatValue = try aDecoder.decodeOrThrow(for: "floatValue")
+            doubleValue = try aDecoder.decodeOrThrow(for: "doubleValue")
+        } catch _ {
+            return nil
+        }
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(int8Value, for: "int8Value")
+        aCoder.encode(int16Value, for: "int16Value")
+        aCoder.encode(int32Value, for: "int32Value")
+        aCoder.encode(int64Value, for: "int64Value")
+        aCoder.encode(uint32Value, for: "uint32Value")
+        aCoder.encode(boolValue, for: "boolValue")
+        aCoder.encode(floatValue, for: "floatValue")
+        aCoder.encode(doubleValue, for: "doubleValue")
+    }
+}
+
+@objc(_DynamicScalarHeavyModel)
+private final class _DynamicScalarHeavyModel: ObjCDynamicCoder {
+    @NSManaged var int8Value: Int8
+    @NSManaged var int16Value: Int16
+    @NSManaged var int32Value: Int32
+    @NSManaged var int64Value: Int64
+    @NSManaged var uint32Value: UInt32
+    @NSManaged var boolValue: Bool
+    @NSManaged var floatValue: Float
+    @NSManaged var doubleValue: Double
+    
+    static func samples() -> [ObjCDynamicCoder] {
+        return (0..<objectCount).map(sample)
+    }
+    
+    static func sample(at index: Int) -> _DynamicScalarHeavyModel {
+        let model = _DynamicScalarHeavyModel()
+        model.int8Value = Int8(truncatingBitPattern: index)
+        model.int16Value = Int16(index)
+        model.int32Value = Int32(index)
+        model.int64Value = Int64(index)
+        model.uint32Value = UInt32(index)
+        model.boolValue = index % 2 == 0
+        model.floatValue = Float(index) / 3
+        model.doubleValue = Double(index) / 7
+        return model
+    }
+}
+
+// MARK: - Struct Heavy Models
+@objc(_PlainStructHeavyModel)
+private final class _PlainStructHeavyModel: NSObject, NSCoding {
+    var point: CGPoint = .zero
+    var size: CGSize = .zero
+    var rect: CGRect = .zero
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map { index in
+            let model = _PlainStructHeavyModel()
+            model.point = CGPoint(x: index, y: index)
+            model.size = CGSize(width: index, height: index)
+            model.rect = CGRect(x: index, y: index, width: index, height: index)
+            return model
+        }
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        point = CGPoint(
+            x: aDecoder.decodeDouble(forKey: "point.x"),
+            y: aDecoder.decodeDouble(forKey: "point.y")
+        )
+        size = CGSize(
+            width: aDecoder.decodeDouble(forKey: "size.width"),
+            height: aDecoder.decodeDouble(forKey: "size.height")
+        )
+        rect = CGRect(
+            x: aDecoder.decodeDouble(forKey: "rect.x"),
+            y: aDecoder.decodeDouble(forKey: "rect.y"),
+            width: aDecoder.decodeDouble(forKey: "rect.width"),
+            height: aDecoder.decodeDouble(forKey: "rect.height")
+        )
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(Double(point.x), forKey: "point.x")
+        aCoder.encode(Double(point.y), forKey: "point.y")
+        aCoder.encode(Double(size.width), forKey: "size.width")
+        aCoder.encode(Double(size.height), forKey: "size.height")
+        aCoder.encode(Double(rect.origin.x), forKey: "rect.x")
+        aCoder.encode(Double(rect.origin.y), forKey: "rect.y")
+        aCoder.encode(Double(rect.size.width), forKey: "rect.width")
+        aCoder.encode(Double(rect.size.height), forKey: "rect.height")
+    }
+}
+
+@objc(_NormalizedStructHeavyModel)
+private final class _NormalizedStructHeavyModel: NSObject, NSCoding {
+    var point: CGPoint = .zero
+    var size: CGSize = .zero
+    var rect: CGRect = .zero
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map { index in
+            let model = _NormalizedStructHeavyModel()
+            model.point = CGPoint(x: index, y: index)
+            model.size = CGSize(width: index, height: index)
+            model.rect = CGRect(x: index, y: index, width: index, height: index)
+            return model
+        }
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        do {
+            point = try aDecoder.decodeOrThrow(for: "point")
+            size = try aDecoder.decodeOrThrow(for: "size")
+            rect = try aDecoder.decodeOrThrow(for: "rect")
+        } catch _ {
+            return nil
+        }
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(point, for: "point")
+        aCoder.encode(size, for: "size")
+        aCoder.encode(rect, for: "rect")
+    }
+}
+
+@objc(_DynamicStructHeavyModel)
+private final class _DynamicStructHeavyModel: ObjCDynamicCoder {
+    @NSManaged var point: CGPoint
+    @NSManaged var size: CGSize
+    @NSManaged var rect: CGRect
+    
+    static func samples() -> [ObjCDynamicCoder] {
+        return (0..<objectCount).map { index in
+            let model = _DynamicStructHeavyModel()
+            model.point = CGPoint(x: index, y: index)
+            model.size = CGSize(width: index, height: index)
+            model.rect = CGRect(x: index, y: index, width: index, height: index)
+            return model
+        }
+    }
+}
+
+// MARK: - String Heavy Models
+@objc(_PlainStringHeavyModel)
+private final class _PlainStringHeavyModel: NSObject, NSCoding {
+    var title: String = ""
+    var subtitle: String = ""
+    var identifier: String = ""
+    var note: String = ""
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map { index in
+            let model = _PlainStringHeavyModel()
+            model.title = "Title \(index)"
+            model.subtitle = "Subtitle of the item at index \(index)"
+            model.identifier = UUID().uuidString
+            model.note = String(repeating: "Note ", count: index % 16)
+            return model
+        }
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        guard
+            let title = aDecoder.decodeObject(forKey: "title") as? String,
+            let subtitle = aDecoder.decodeObject(forKey: "subtitle") as? String,
+            let identifier = aDecoder.decodeObject(forKey: "identifier") as? String,
+            let note = aDecoder.decodeObject(forKey: "note") as? String
+            else { return nil }
+        self.title = title
+        self.subtitle = subtitle
+        self.identifier = identifier
+        self.note = note
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(title, forKey: "title")
+        aCoder.encode(subtitle, forKey: "subtitle")
+        aCoder.encode(identifier, forKey: "identifier")
+        aCoder.encode(note, forKey: "note")
+    }
+}
+
+@objc(_NormalizedStringHeavyModel)
+private final class _NormalizedStringHeavyModel: NSObject, NSCoding {
+    var title: String = ""
+    var subtitle: String = ""
+    var identifier: String = ""
+    var note: String = ""
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map { index in
+            let model = _NormalizedStringHeavyModel()
+            model.title = "Title \(index)"
+            model.subtitle = "Subtitle of the item at index \(index)"
+            model.identifier = UUID().uuidString
+            model.note = String(repeating: "Note ", count: index % 16)
+            return model
+        }
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        do {
+            title = try aDecoder.decodeOrThrow(for: "title")
+            subtitle = try aDecoder.decodeOrThrow(for: "subtitle")
+            identifier = try aDecoder.decodeOrThrow(for: "identifier")
+            note = try aDecoder.decodeOrThrow(for: "note")
+        } catch _ {
+            return nil
+        }
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(title, for: "title")
+        aCoder.encode(subtitle, for: "subtitle")
+        aCoder.encode(identifier, for: "identifier")
+        aCoder.encode(note, for: "note")
+    }
+}
+
+@objc(_DynamicStringHeavyModel)
+private final class _DynamicStringHeavyModel: ObjCDynamicCoder {
+    @NSManaged var title: NSString
+    @NSManaged var subtitle: NSString
+    @NSManaged var identifier: NSString
+    @NSManaged var note: NSString
+    
+    static func samples() -> [ObjCDynamicCoder] {
+        return (0..<objectCount).map { index in
+            let model = _DynamicStringHeavyModel()
+            model.title = "Title \(index)" as NSString
+            model.subtitle = "Subtitle of the item at index \(index)" as NSString
+            model.identifier = UUID().uuidString as NSString
+            model.note = String(repeating: "Note ", count: index % 16) as NSString
+            return model
+        }
+    }
+}
+
+// MARK: - Nested Models
+@objc(_PlainNestedModel)
+private final class _PlainNestedModel: NSObject, NSCoding {
+    var name: String = ""
+    var children: [NSObject] = []
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map { index in
+            let model = _PlainNestedModel()
+            model.name = "Node \(index)"
+            model.children = (0..<4).map(_PlainScalarHeavyModel.sample)
+            return model
+        }
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        guard
+            let name = aDecoder.decodeObject(forKey: "name") as? String,
+            let children = aDecoder.decodeObject(forKey: "children") as? [NSObject]
+            else { return nil }
+        self.name = name
+        self.children = children
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(name, forKey: "name")
+        aCoder.encode(children, forKey: "children")
+    }
+}
+
+@objc(_NormalizedNestedModel)
+private final class _NormalizedNestedModel: NSObject, NSCoding {
+    var name: String = ""
+    var children: [NSObject] = []
+    
+    static func samples() -> [NSObject] {
+        return (0..<objectCount).map { index in
+            let model = _NormalizedNestedModel()
+            model.name = "Node \(index)"
+            model.children = (0..<4).map(_NormalizedScalarHeavyModel.sample)
+            return model
+        }
+    }
+    
+    override init() {
+        super.init()
+    }
+    
+    init?(coder aDecoder: NSCoder) {
+        do {
+            name = try aDecoder.decodeOrThrow(for: "name")
+            let children: NSArray = try aDecoder.decodeOrThrow(for: "children")
+            self.children = children as? [NSObject] ?? []
+        } catch _ {
+            return nil
+        }
+        super.init()
+    }
+    
+    func encode(with aCoder: NSCoder) {
+        aCoder.encode(name, for: "name")
+        aCoder.encode(children as NSArray, for: "children")
+    }
+}
+
+@objc(_DynamicNestedModel)
+private final class _DynamicNestedModel: ObjCDynamicCoder {
+    @NSManaged var name: NSString
+    @NSManaged var children: NSArray
+    
+    static func samples() -> [ObjCDynamicCoder] {
+        return (0..<objectCount).map { index in
+            let model = _DynamicNestedModel()
+            model.name = "Node \(index)" as NSString
+            model.children = (0..<4).map(_DynamicScalarHeavyModel.sample)
+                as NSArray
+            return model
+        }
+    }
+}
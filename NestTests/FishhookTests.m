@@ -0,0 +1,63 @@
+//
+//  FishhookTests.m
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+@import XCTest;
+
+#import <unistd.h>
+
+#import "../Nest/Miscellaneous/fishhook.h"
+
+static pid_t (* _FishhookTestsOriginalGetppidOfFirstHook)(void);
+static pid_t (* _FishhookTestsOriginalGetppidOfSecondHook)(void);
+
+static NSUInteger _FishhookTestsFirstHookCallCount;
+static NSUInteger _FishhookTestsSecondHookCallCount;
+
+static pid_t _FishhookTestsFirstHookGetppid(void) {
+    _FishhookTestsFirstHookCallCount ++;
+    return _FishhookTestsOriginalGetppidOfFirstHook();
+}
+
+static pid_t _FishhookTestsSecondHookGetppid(void) {
+    _FishhookTestsSecondHookCallCount ++;
+    return _FishhookTestsOriginalGetppidOfSecondHook();
+}
+
+@interface FishhookTests : XCTestCase
+@end
+
+@implementation FishhookTests
+- (void)testRebindingSameSymbolTwiceChainsHooks {
+    pid_t parentProcessID = getppid();
+    
+    struct rebinding firstRebinding = {
+        "getppid",
+        (void *)_FishhookTestsFirstHookGetppid,
+        (void **)&_FishhookTestsOriginalGetppidOfFirstHook
+    };
+    XCTAssertEqual(rebind_symbols(&firstRebinding, 1), 0);
+    
+    struct rebinding secondRebinding = {
+        "getppid",
+        (void *)_FishhookTestsSecondHookGetppid,
+        (void **)&_FishhookTestsOriginalGetppidOfSecondHook
+    };
+    XCTAssertEqual(rebind_symbols(&secondRebinding, 1), 0);
+    
+    // The second hook calls the first one instead of skipping it.
+    XCTAssert(_FishhookTestsOriginalGetppidOfSecondHook
+              == _FishhookTestsFirstHookGetppid);
+    
+    _FishhookTestsFirstHookCallCount = 0;
+    _FishhookTestsSecondHookCallCount = 0;
+    
+    XCTAssertEqual(getppid(), parentProcessID);
+    XCTAssertEqual(_FishhookTestsSecondHookCallCount, 1);
+    XCTAssertEqual(_FishhookTestsFirstHookCallCount, 1);
+}
+@end
@@ -120,4 +120,74 @@ class NSCoderModernizationTest: XCTestCase {
         
     }
     
+    func testBulkCoding() {
+        let doubles: [Double] = (0..<1000).map { Double($0) / 3 }
+        let int32s: ContiguousArray<Int32> = ContiguousArray(0..<1000)
+        let points: [CGPoint] = (0..<100).map { CGPoint(x: $0, y: -$0) }
+        
+        let data = NSMutableData()
+        let archiver = NSKeyedArchiver(forWritingWith: data)
+        archiver.encode(doubles, for: "doubles")
+        archiver.encode(int32s, for: "int32s")
+        archiver.encode(points, for: "points")
+        archiver.encode([1, 9, 8, 4] as NSArray, forKey: "legacy")
+        archiver.finishEncoding()
+        
+        let unarchiver = NSKeyedUnarchiver(forReadingWith: data as Data)
+        
+        let unarchivedDoubles: [Double]? = unarchiver.decode(for: "doubles")
+        let unarchivedInt32s: ContiguousArray<Int32>?
+            = unarchiver.decode(for: "int32s")
+        let unarchivedPoints: [CGPoint]? = unarchiver.decode(for: "points")
+        let unarchivedLegacy: [Int]? = unarchiver.decode(for: "legacy")
+        
+        XCTAssert(unarchivedDoubles.map { $0 == doubles } ?? false)
+        XCTAssert(unarchivedInt32s.map { $0 == int32s } ?? false)
+        XCTAssert(unarchivedPoints.map { $0 == points } ?? false)
+        XCTAssert(unarchivedLegacy.map { $0 == [1, 9, 8, 4] } ?? false)
+    }
+    
+    func testBulkBufferCoding() {
+        let doubles: [Double] = (0..<1000).map { Double($0) / 3 }
+        
+        let data = NSMutableData()
+        let archiver = NSKeyedArchiver(forWritingWith: data)
+        doubles.withUnsafeBufferPointer {
+            archiver.encodeBulk($0, for: "doubles")
+        }
+        archiver.finishEncoding()
+        
+        let unarchiver = NSKeyedUnarchiver(forReadingWith: data as Data)
+        
+        let buffer: UnsafeMutableBufferPointer<Double>?
+            = unarchiver.decodeBulk(for: "doubles")
+        let array: [Double]? = unarchiver.decode(for: "doubles")
+        
+        XCTAssert(buffer.map { Array($0) == doubles } ?? false)
+        XCTAssert(array.map { $0 == doubles } ?? false)
+        
+        if let buffer = buffer {
+            buffer.baseAddress?.deallocate(capacity: buffer.count)
+        }
+    }
+    
+    func testBulkCodingPlatformWidth() {
+        // A buffer of `Int` written on a 32-bit platform.
+        var bytes: [UInt8] = [0x4E, 0x53, 0x54, 0x42, 4, 0, 1, 0]
+        bytes += [3, 0, 0, 0, 0, 0, 0, 0]
+        bytes += [1, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F]
+        
+        let data = NSMutableData()
+        let archiver = NSKeyedArchiver(forWritingWith: data)
+        archiver.encode(Data(bytes: bytes) as NSData, forKey: "ints")
+        archiver.finishEncoding()
+        
+        let unarchiver = NSKeyedUnarchiver(forReadingWith: data as Data)
+        
+        let ints: [Int]? = unarchiver.decode(for: "ints")
+        let mismatched: [Int64]? = unarchiver.decode(for: "ints")
+        
+        XCTAssert(ints.map { $0 == [1, -1, Int(Int32.max)] } ?? false)
+        XCTAssertNil(mismatched)
+    }
 }
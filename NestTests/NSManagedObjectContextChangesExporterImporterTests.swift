@@ -172,6 +172,100 @@ class NSManagedObjectContextChangesExporterImporterTests: XCTestCase,
         }
     }
     
+    func testExportAndImportWithJournal() {
+        self.didImporterCallDelegateDidImport = expectation(
+            description: "Importer did call delegate's did import."
+        )
+        
+        let journal = NSManagedObjectContextChangesJournal(
+            url: URL(fileURLWithPath: NSTemporaryDirectory())
+                .appendingPathComponent(UUID().uuidString)
+        )
+        
+        self.exportPersistentController.performAndWait { (ctx) in
+            let exporter = NSManagedObjectContextChangesExporter(
+                context: ctx, journal: journal
+            )
+            ctx.changesExporter = exporter
+            
+            // Each save is exported as a record.
+            for idx in 0..<_changesAmount {
+                let anObject = ManagedObject(managedObjectContext: ctx)
+                anObject.id = idx
+                
+                if idx % 256 == 255 {
+                    try! ctx.save()
+                }
+            }
+        }
+        
+        var progress: Progress?
+        
+        self.importPersistentController.performAndWait { (ctx) in
+            let importer = NSManagedObjectContextChangesImporter(
+                context: ctx, journal: journal
+            )
+            importer.delegate = self
+            importer.chunkSize = 1000
+            progress = importer.`import`()
+        }
+        
+        XCTAssert(progress != nil)
+        
+        waitForExpectations(timeout: 5) { (errorOrNil) in
+            if let error = errorOrNil {
+                NSLog(error.localizedDescription)
+            }
+        }
+        
+        XCTAssert(progress?.fractionCompleted == 1)
+        XCTAssert(journal.rotatedJournalURLs.isEmpty)
+    }
+    
+    func testJournal() {
+        let url = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent(UUID().uuidString)
+        
+        let journal = NSManagedObjectContextChangesJournal(url: url)
+        
+        let uris = (0..<16).map {
+            URL(string: "x-coredata://F00D/ManagedObject/p\($0)")!
+        }
+        
+        do {
+            try journal.append([NSInsertedObjectsKey: uris])
+            try journal.append([NSDeletedObjectsKey: [uris[0]]])
+            
+            let rotatedJournalURLs = try journal.rotate()
+            
+            XCTAssert(rotatedJournalURLs.count == 1)
+            
+            // Appending after rotating goes to a new journal.
+            try journal.append([NSUpdatedObjectsKey: [uris[1]]])
+            
+            var records = [NSManagedObjectContextChangesJournal.Changes]()
+            
+            for eachURL in rotatedJournalURLs {
+                try NSManagedObjectContextChangesJournal.forEachRecord(
+                    inJournalAt: eachURL
+                ) { records.append($0) }
+                try journal.removeRotatedJournal(at: eachURL)
+            }
+            
+            XCTAssert(records.count == 2)
+            XCTAssert(records.first?[NSInsertedObjectsKey] ?? [] == uris)
+            XCTAssert(records.last?[NSDeletedObjectsKey] ?? [] == [uris[0]])
+            XCTAssert(journal.rotatedJournalURLs.isEmpty)
+            XCTAssert(try journal.rotate().count == 1)
+        } catch let error {
+            XCTFail("\(error)")
+        }
+        
+        journal.rotatedJournalURLs.forEach {
+            try? journal.removeRotatedJournal(at: $0)
+        }
+    }
+    
     // MARK: - NSManagedObjectContextChangesExporterDelegate
     @nonobjc
     func persistentUserDefault(
@@ -7,3 +7,4 @@
 //
 
 #import "ObjCGraftImplementationTest.h"
+#import "AllocationCounting.h"
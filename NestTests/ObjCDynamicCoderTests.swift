@@ -429,6 +429,247 @@ class ObjCDynamicCoderTests: XCTestCase {
     }
 }
 
+extension ObjCDynamicCoderTests {
+    func testColumnarCoding() {
+        let objects: [_ArchivableEnumFloatingPointAccessorObjCBridged]
+            = (0..<100).map { index in
+                let object = _ArchivableEnumFloatingPointAccessorObjCBridged()
+                object.doubleValue = Double(index) / 3
+                object.floatValue = Float(index) / 7
+                return object
+        }
+        
+        let data = NSMutableData()
+        let archiver = NSKeyedArchiver(forWritingWith: data)
+        _ArchivableEnumFloatingPointAccessorObjCBridged.encodeObjects(
+            objects, with: archiver, forKey: "objects"
+        )
+        archiver.finishEncoding()
+        
+        let unarchiver = NSKeyedUnarchiver(forReadingWith: data as Data)
+        let decoded = _ArchivableEnumFloatingPointAccessorObjCBridged
+            .decodeObjects(with: unarchiver, forKey: "objects")
+            as? [_ArchivableEnumFloatingPointAccessorObjCBridged]
+        
+        XCTAssert(decoded?.count == objects.count)
+        
+        for (original, unarchived) in zip(objects, decoded ?? []) {
+            XCTAssert(original.doubleValue == unarchived.doubleValue)
+            XCTAssert(original.floatValue == unarchived.floatValue)
+        }
+    }
+    
+    func testColumnarCodingOfStructsAndObjects() {
+        let ranges: [_ArchivableEnumFoundationAccessorObjCBridged]
+            = (0..<10).map { index in
+                let object = _ArchivableEnumFoundationAccessorObjCBridged()
+                object.rangeValue = NSRange(location: index, length: index * 2)
+                return object
+        }
+        
+        let strings: [_ArchivableEnumObjectAccessorObjCBridged]
+            = (0..<10).map { index in
+                let object = _ArchivableEnumObjectAccessorObjCBridged()
+                object.objectValue = "\(index)" as NSString
+                return object
+        }
+        
+        let data = NSMutableData()
+        let archiver = NSKeyedArchiver(forWritingWith: data)
+        _ArchivableEnumFoundationAccessorObjCBridged.encodeObjects(
+            ranges, with: archiver, forKey: "ranges"
+        )
+        _ArchivableEnumObjectAccessorObjCBridged.encodeObjects(
+            strings, with: archiver, forKey: "strings"
+        )
+        archiver.finishEncoding()
+        
+        let unarchiver = NSKeyedUnarchiver(forReadingWith: data as Data)
+        let decodedRanges = _ArchivableEnumFoundationAccessorObjCBridged
+            .decodeObjects(with: unarchiver, forKey: "ranges")
+            as? [_ArchivableEnumFoundationAccessorObjCBridged]
+        let decodedStrings = _ArchivableEnumObjectAccessorObjCBridged
+            .decodeObjects(with: unarchiver, forKey: "strings")
+            as? [_ArchivableEnumObjectAccessorObjCBridged]
+        
+        XCTAssert(decodedRanges?.count == ranges.count)
+        XCTAssert(decodedStrings?.count == strings.count)
+        
+        for (original, unarchived) in zip(ranges, decodedRanges ?? []) {
+            XCTAssert(original.rangeValue == unarchived.rangeValue)
+        }
+        
+        for (original, unarchived) in zip(strings, decodedStrings ?? []) {
+            XCTAssert(
+                original.objectValue as? String
+                    == unarchived.objectValue as? String
+            )
+        }
+    }
+}
+
+extension ObjCDynamicCoderTests {
+    func testMigrationPlan() {
+        let legacyObject = _MigrationTestLegacyObject()
+        legacyObject.title = "Nest"
+        legacyObject.amount = 4
+        
+        let data = NSKeyedArchiver.archivedData(withRootObject: legacyObject)
+        
+        let unarchiver = NSKeyedUnarchiver(forReadingWith: data)
+        unarchiver.setClass(
+            _MigrationTestObject.self,
+            forClassName: "_MigrationTestLegacyObject"
+        )
+        
+        let unarchived = unarchiver
+            .decodeObject(forKey: NSKeyedArchiveRootObjectKey)
+            as? _MigrationTestObject
+        
+        XCTAssert(unarchived?.name == "Nest")
+        XCTAssert(unarchived?.amount == 40)
+        XCTAssert(unarchived?.rating == 5)
+    }
+}
+
+extension ObjCDynamicCoderTests {
+    func testMappedArchive() {
+        let objects: [_MappedArchiveTestObject] = (0..<100).map { index in
+            let object = _MappedArchiveTestObject()
+            object.name = "Nest \(index % 10)" as NSString
+            object.amount = Int64(index)
+            object.range = NSRange(location: index, length: index * 2)
+            return object
+        }
+        
+        let url = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("\(UUID().uuidString).nestmap")
+        
+        defer { try? FileManager.default.removeItem(at: url) }
+        
+        do {
+            try ObjCDynamicObjectMappedArchive.writeObjects(
+                objects, of: _MappedArchiveTestObject.self, to: url
+            )
+            
+            let archive = try ObjCDynamicObjectMappedArchive(contentsOf: url)
+            
+            XCTAssert(archive.count == objects.count)
+            
+            for (index, original) in objects.enumerated() {
+                let mapped = archive[index] as? _MappedArchiveTestObject
+                XCTAssert(mapped?.name == original.name)
+                XCTAssert(mapped?.amount == original.amount)
+                XCTAssert(mapped.map { $0.range == original.range } ?? false)
+            }
+            
+            // Writing copies the mapped values and leaves the archive intact.
+            let written = archive[0] as? _MappedArchiveTestObject
+            written?.amount = 1984
+            
+            XCTAssert(written?.amount == 1984)
+            XCTAssert(written?.name == objects[0].name)
+            XCTAssert((archive[0] as? _MappedArchiveTestObject)?.amount == 0)
+        } catch let error {
+            XCTFail("\(error)")
+        }
+    }
+    
+    func testMappedArchiveLeavesOutObjectProperties() {
+        let object = _MappedArchiveTestObject()
+        object.name = "Nest"
+        
+        let url = URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("\(UUID().uuidString).nestmap")
+        
+        defer { try? FileManager.default.removeItem(at: url) }
+        
+        do {
+            // Properties which cannot be mapped don't fail writing until
+            // they hold a value.
+            try ObjCDynamicObjectMappedArchive.writeObjects(
+                [object], of: _MappedArchiveTestObject.self, to: url
+            )
+            
+            let archive = try ObjCDynamicObjectMappedArchive(contentsOf: url)
+            
+            let mapped = archive[0] as? _MappedArchiveTestObject
+            XCTAssert(mapped?.name == "Nest")
+            XCTAssert(mapped?.date == nil)
+        } catch let error {
+            XCTFail("\(error)")
+        }
+        
+        object.date = NSDate()
+        
+        do {
+            try ObjCDynamicObjectMappedArchive.writeObjects(
+                [object], of: _MappedArchiveTestObject.self, to: url
+            )
+            XCTFail("Writing an unsupported value shall fail.")
+        } catch let error {
+            let error = error as NSError
+            XCTAssert(error.domain == ObjCDynamicObjectMappedArchiveErrorDomain)
+            XCTAssert(
+                error.code
+                    == ObjCDynamicObjectMappedArchiveError.unsupportedValue.rawValue
+            )
+        }
+    }
+}
+
+@objc(_MappedArchiveTestObject)
+private final class _MappedArchiveTestObject: ObjCDynamicObject {
+    @NSManaged
+    fileprivate var name: NSString
+    
+    @NSManaged
+    fileprivate var amount: Int64
+    
+    @NSManaged
+    fileprivate var range: NSRange
+    
+    @NSManaged
+    fileprivate var date: NSDate?
+}
+
+@objc(_MigrationTestLegacyObject)
+private final class _MigrationTestLegacyObject: ObjCDynamicCoder {
+    @NSManaged
+    fileprivate var title: NSString
+    
+    @NSManaged
+    fileprivate var amount: Int32
+}
+
+@objc(_MigrationTestObject)
+private final class _MigrationTestObject: ObjCDynamicCoder {
+    @NSManaged
+    fileprivate var name: NSString
+    
+    @NSManaged
+    fileprivate var amount: Int64
+    
+    @NSManaged
+    fileprivate var rating: Double
+    
+    override class func version() -> Int {
+        return 1
+    }
+    
+    override class func migrationPlan(from fromVersion: Int, to toVersion: Int)
+        -> ObjCDynamicCoderMigrationPlan?
+    {
+        let plan = ObjCDynamicCoderMigrationPlan()
+        plan.renameKey("title", toKey: "name")
+        plan.convertValue(forKey: "amount") { value in
+            (value as? NSNumber).map { NSNumber(value: $0.int64Value * 10) }
+        }
+        plan.setDefaultValue(NSNumber(value: 5.0), forKey: "rating")
+        return plan
+    }
+}
+
 private class ArchivableObject: NSObject, NSCoding {
     fileprivate var archivableEnum: ArchivableEnum
     
@@ -116,4 +116,29 @@ class ObjCGraftProtocolImplementationTest: XCTestCase {
         XCTAssert(grafted is ObjectA)
         XCTAssert(!(grafted is ObjectB))
     }
+    
+    func testGraftedClassIsReused() {
+        let objectA1 = ObjectA()
+        let objectA2 = ObjectA()
+        
+        ObjCGraftProtocolImplementation(of: AProtocol.self, on: ObjectB.self, to: objectA1)
+        ObjCGraftProtocolImplementation(of: AProtocol.self, on: ObjectB.self, to: objectA2)
+        
+        let GraftedClass: AnyClass = type(of: objectA1)
+        
+        XCTAssert(GraftedClass != ObjectA.self)
+        XCTAssert(type(of: objectA2) == GraftedClass)
+        
+        ObjCGraftProtocolImplementation(of: AProtocol.self, on: ObjectB.self, to: objectA1)
+        
+        XCTAssert(type(of: objectA1) == GraftedClass)
+        
+        objectA2.instanceMethod()
+        
+        XCTAssert(objectA2.instanceMethodSource.contains(.objectB))
+        
+        ObjCUngraftProtocolImplementationsAll(on: objectA1)
+        
+        XCTAssert(type(of: objectA1) == ObjectA.self)
+    }
 }
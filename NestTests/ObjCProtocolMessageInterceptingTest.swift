@@ -0,0 +1,112 @@
+//
+//  ObjCProtocolMessageInterceptingTest.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import XCTest
+import Nest
+
+@objc private protocol Pinging: NSObjectProtocol {
+    @objc optional func ping()
+}
+
+private class Destination: NSObject, Pinging {
+    let name: String
+    
+    var received: [String] = []
+    
+    init(name: String) {
+        self.name = name
+    }
+    
+    @objc func ping() {
+        received.append(name)
+    }
+}
+
+private class Intercepting: NSObject, ObjCProtocolMessageIntercepting {
+    override func responds(to aSelector: Selector) -> Bool {
+        return nest_responds(to: aSelector)
+    }
+    
+    override func forwardingTarget(for aSelector: Selector) -> Any? {
+        return nest_forwardingTarget(for: aSelector)
+    }
+}
+
+class ObjCProtocolMessageInterceptingTest: XCTestCase {
+    private let selector = #selector(Pinging.ping)
+    
+    private var intercepting: Intercepting!
+    
+    override func setUp() {
+        super.setUp()
+        
+        intercepting = Intercepting()
+        intercepting.addInterceptedProtocol(Pinging.self)
+    }
+    
+    override func tearDown() {
+        intercepting = nil
+        super.tearDown()
+    }
+    
+    func testDispatchAfterAppendingInsertingAndRemoving() {
+        let first = Destination(name: "first")
+        let second = Destination(name: "second")
+        
+        intercepting.appendDispatchDestination(first)
+        _ = intercepting.perform(selector)
+        
+        intercepting.insertDispatchDestination(second, at: 0)
+        _ = intercepting.perform(selector)
+        
+        intercepting.removeDispatchDestination(second)
+        _ = intercepting.perform(selector)
+        
+        XCTAssertEqual(first.received, ["first", "first"])
+        XCTAssertEqual(second.received, ["second"])
+    }
+    
+    func testDispatchAfterDestinationDied() {
+        let survivor = Destination(name: "survivor")
+        
+        autoreleasepool {
+            let doomed = Destination(name: "doomed")
+            intercepting.appendDispatchDestination(doomed)
+            intercepting.appendDispatchDestination(survivor)
+            
+            _ = intercepting.perform(selector)
+            
+            XCTAssertEqual(doomed.received, ["doomed"])
+        }
+        
+        _ = intercepting.perform(selector)
+        
+        XCTAssertEqual(survivor.received, ["survivor"])
+        XCTAssertEqual(intercepting.dispatchDestinations.count, 1)
+    }
+    
+    func testNegativeEntriesAreInvalidated() {
+        // Neither any destination nor the object itself responds.
+        XCTAssertFalse(intercepting.responds(to: selector))
+        XCTAssertNil(intercepting.forwardingTarget(for: selector))
+        
+        let destination = Destination(name: "destination")
+        intercepting.appendDispatchDestination(destination)
+        
+        XCTAssert(intercepting.responds(to: selector))
+        XCTAssert(intercepting.forwardingTarget(for: selector) as? Destination
+            === destination)
+        
+        intercepting.removeDispatchDestination(at: 0)
+        
+        XCTAssertFalse(intercepting.responds(to: selector))
+        
+        // Selectors of no intercepted protocol aren't dispatched.
+        XCTAssert(intercepting.responds(to: #selector(NSObject.copy)))
+    }
+}
@@ -95,6 +95,28 @@ class ObjCProtocolMessageInterceptorTest: XCTestCase, MessagePool {
         
         XCTAssert(hasOnlyOneMiddleMenToken, "Middle men forwarding not pass")
     }
+    
+    func testRespondingFollowsTargets() {
+        let selector = #selector(
+            OperatorDelegate.operatorDidSendMessageToReceiver
+        )
+        
+        let aProtocolInterceptor = ObjCProtocolMessageInterceptor
+            .make(protocol: OperatorDelegate.self)
+        
+        // Intercepted methods are implemented with trampolines, which
+        // shall not make the interceptor respond without targets.
+        XCTAssertFalse(aProtocolInterceptor.responds(to: selector))
+        
+        aProtocolInterceptor.receiver = realDelegate
+        
+        XCTAssert(aProtocolInterceptor.responds(to: selector))
+        
+        (aProtocolInterceptor as? OperatorDelegate)?
+            .operatorDidSendMessageToReceiver?()
+        
+        XCTAssert(messagePool == [ReceiverToken])
+    }
 }
 
 //MARK: - OperatorDelegate
@@ -0,0 +1,97 @@
+//
+//  ObjCSelectorMessageInterceptorTest.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import XCTest
+import Nest
+
+private class Responder: NSObject {
+    let name: String
+    
+    var received: [String] = []
+    
+    init(name: String) {
+        self.name = name
+    }
+    
+    @objc func ping() {
+        received.append(name)
+    }
+}
+
+class ObjCSelectorMessageInterceptorTest: XCTestCase {
+    private let selector = #selector(Responder.ping)
+    
+    private var interceptor: ObjCSelectorMessageInterceptor!
+    
+    private var receiver: Responder!
+    
+    override func setUp() {
+        super.setUp()
+        
+        receiver = Responder(name: "receiver")
+        interceptor = ObjCSelectorMessageInterceptor(selector: selector)
+        interceptor.receiver = receiver
+    }
+    
+    override func tearDown() {
+        interceptor = nil
+        receiver = nil
+        super.tearDown()
+    }
+    
+    func testAddingAndRemovingMiddleManResolvesTargetAgain() {
+        let middleMan = Responder(name: "middle man")
+        
+        // Resolves and caches the receiver.
+        XCTAssert(interceptor.forwardingTarget(for: selector) as? Responder
+            === receiver)
+        
+        interceptor.add(middleMan: middleMan)
+        
+        XCTAssert(interceptor.forwardingTarget(for: selector) as? Responder
+            === middleMan)
+        
+        _ = interceptor.remove(middleMan: middleMan)
+        
+        XCTAssert(interceptor.forwardingTarget(for: selector) as? Responder
+            === receiver)
+    }
+    
+    func testMessageGoesToReceiverAfterMiddleManDied() {
+        autoreleasepool {
+            let middleMan = Responder(name: "middle man")
+            interceptor.add(middleMan: middleMan)
+            
+            _ = interceptor.perform(selector)
+            
+            XCTAssertEqual(middleMan.received, ["middle man"])
+        }
+        
+        XCTAssert(interceptor.middleMen.isEmpty)
+        
+        _ = interceptor.perform(selector)
+        
+        XCTAssertEqual(receiver.received, ["receiver"])
+    }
+    
+    func testMessageGoesToNewReceiver() {
+        _ = interceptor.perform(selector)
+        
+        let newReceiver = Responder(name: "new receiver")
+        interceptor.receiver = newReceiver
+        
+        _ = interceptor.perform(selector)
+        
+        XCTAssertEqual(receiver.received, ["receiver"])
+        XCTAssertEqual(newReceiver.received, ["new receiver"])
+        
+        interceptor.receiver = nil
+        
+        XCTAssertFalse(interceptor.responds(to: selector))
+    }
+}
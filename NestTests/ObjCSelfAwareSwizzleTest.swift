@@ -0,0 +1,143 @@
+//
+//  ObjCSelfAwareSwizzleTest.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import XCTest
+import ObjectiveC
+import Nest
+
+private typealias ValueImpl = @convention(c) (AnyObject, Selector) -> Int
+
+private class _InvalidBatchTestObject: NSObject {
+    @objc dynamic func value() -> Int { return 1 }
+    
+    @objc dynamic func swizzledValue() -> Int { return 2 }
+}
+
+private class _DuplicateBatchTestObject: NSObject {
+    @objc dynamic func value() -> Int { return 1 }
+    
+    @objc dynamic func swizzledValue() -> Int { return 2 }
+}
+
+private class _OrderingTestBaseObject: NSObject {
+    @objc dynamic func value() -> Int { return 1 }
+}
+
+private class _OrderingTestSubobject: _OrderingTestBaseObject {}
+
+class ObjCSelfAwareSwizzleTest: XCTestCase {
+    private let valueSelector = #selector(_OrderingTestBaseObject.value)
+    
+    /// Returns a swizzle making `value()` of `aClass` return the original
+    /// value plus `addend`.
+    private func makeAddingSwizzle(
+        on aClass: AnyClass,
+        addend: Int,
+        original: UnsafeMutablePointer<IMP>
+        )
+        -> ObjCSelfAwareSwizzle
+    {
+        let selector = valueSelector
+        let block: @convention(block) (AnyObject) -> Int = { (object) in
+            let originalImpl = unsafeBitCast(original.pointee, to: ValueImpl.self)
+            return originalImpl(object, selector) + addend
+        }
+        
+        return swizzle(
+            instanceSelector: selector,
+            on: aClass,
+            original: original,
+            swizzled: imp_implementationWithBlock(
+                unsafeBitCast(block, to: AnyObject.self)
+            )
+        )
+    }
+    
+    func testInvalidSwizzleLeavesEveryClassUntouched() {
+        let swizzles = [
+            swizzle(
+                instanceSelector: #selector(_InvalidBatchTestObject.value),
+                with: #selector(_InvalidBatchTestObject.swizzledValue),
+                on: _InvalidBatchTestObject.self
+            ),
+            swizzle(
+                instanceSelector: #selector(_InvalidBatchTestObject.value),
+                with: NSSelectorFromString("_nonexistentSelector"),
+                on: _InvalidBatchTestObject.self
+            ),
+        ]
+        
+        var performedCount = -1
+        var error: NSError?
+        
+        let succeeded = ObjCSelfAwareSwizzle.perform(
+            swizzles, performedCount: &performedCount, error: &error
+        )
+        
+        XCTAssertFalse(succeeded)
+        XCTAssertNotNil(error)
+        XCTAssertEqual(performedCount, 0)
+        XCTAssertEqual(_InvalidBatchTestObject().value(), 1)
+        XCTAssertEqual(_InvalidBatchTestObject().swizzledValue(), 2)
+    }
+    
+    func testDuplicateSwizzlesArePerformedOnce() {
+        // Exchanging twice would restore the implementations.
+        let swizzles = (0..<2).map { _ in
+            swizzle(
+                instanceSelector: #selector(_DuplicateBatchTestObject.value),
+                with: #selector(_DuplicateBatchTestObject.swizzledValue),
+                on: _DuplicateBatchTestObject.self
+            )
+        }
+        
+        var performedCount = 0
+        var error: NSError?
+        
+        let succeeded = ObjCSelfAwareSwizzle.perform(
+            swizzles, performedCount: &performedCount, error: &error
+        )
+        
+        XCTAssert(succeeded)
+        XCTAssertNil(error)
+        XCTAssertEqual(performedCount, 1)
+        XCTAssertEqual(_DuplicateBatchTestObject().value(), 2)
+    }
+    
+    func testSuperclassIsSwizzledBeforeSubclass() {
+        let baseOriginal = UnsafeMutablePointer<IMP>.allocate(capacity: 1)
+        let subOriginal = UnsafeMutablePointer<IMP>.allocate(capacity: 1)
+        
+        // Swizzled implementations live as long as the classes.
+        let swizzles = [
+            makeAddingSwizzle(
+                on: _OrderingTestSubobject.self,
+                addend: 100,
+                original: subOriginal
+            ),
+            makeAddingSwizzle(
+                on: _OrderingTestBaseObject.self,
+                addend: 10,
+                original: baseOriginal
+            ),
+        ]
+        
+        var error: NSError?
+        
+        XCTAssert(
+            ObjCSelfAwareSwizzle.perform(
+                swizzles, performedCount: nil, error: &error
+            )
+        )
+        XCTAssertNil(error)
+        
+        // The subclass calls through to the swizzled superclass.
+        XCTAssertEqual(_OrderingTestBaseObject().value(), 11)
+        XCTAssertEqual(_OrderingTestSubobject().value(), 111)
+    }
+}
@@ -0,0 +1,513 @@
+//
+//  PersistentControllerTests.swift
+//  Nest
+//
+//  Created by Manfred on 19/10/2026.
+//
+//
+
+import XCTest
+
+@testable
+import Nest
+
+import CoreData
+
+@available(
+iOSApplicationExtension 9.0,
+OSXApplicationExtension 10.11,
+tvOS 9.0,
+watchOS 2.0,
+*)
+class PersistentControllerTests: XCTestCase {
+    internal var persistentController: PersistentController!
+    
+    override func setUp() {
+        super.setUp()
+        
+        persistentController = PersistentController(
+            store: .inMemory,
+            modelBundle: Bundle(for: type(of: self)),
+            modelName: "NSManagedObjectContextChangesExporterImporterTests"
+        )
+        persistentController.name = "test"
+    }
+    
+    override func tearDown() {
+        persistentController = nil
+        super.tearDown()
+    }
+    
+    func testCoalescingSave() {
+        persistentController.saveMode = .coalescing(
+            window: 0.05, changeCountThreshold: 1000
+        )
+        
+        let saves = (0..<10).map { index -> XCTestExpectation in
+            let isSaved = expectation(description: "Save \(index) is durable.")
+            
+            persistentController.perform { (ctx) in
+                let anObject = ManagedObject(managedObjectContext: ctx)
+                anObject.id = Int32(index)
+            }
+            
+            persistentController.save { (errorOrNil) in
+                XCTAssert(errorOrNil == nil)
+                isSaved.fulfill()
+            }
+            
+            return isSaved
+        }
+        
+        XCTAssert(saves.count == 10)
+        
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        let hasChanges = persistentController.performAndWait { (ctx) in
+            ctx.hasChanges
+        }
+        
+        XCTAssertFalse(hasChanges)
+    }
+    
+    func testReadContextPool() {
+        persistentController.readContextPoolSize = 4
+        
+        persistentController.performAndWait { (ctx) in
+            for idx in 0..<100 {
+                let anObject = ManagedObject(managedObjectContext: ctx)
+                anObject.id = Int32(idx)
+            }
+        }
+        
+        let isSaved = expectation(description: "Objects are saved.")
+        
+        persistentController.save { _ in isSaved.fulfill() }
+        
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        let reads = (0..<8).map { index -> XCTestExpectation in
+            let isRead = expectation(description: "Read \(index) is done.")
+            
+            persistentController.performRead { (ctx) in
+                let fetchRequest = NSFetchRequest<ManagedObject>(
+                    entityName: "ManagedObject"
+                )
+                XCTAssert((try? ctx.count(for: fetchRequest)) == 100)
+                XCTAssert(ctx.parent == nil)
+                isRead.fulfill()
+            }
+            
+            return isRead
+        }
+        
+        XCTAssert(reads.count == 8)
+        
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        let count = persistentController.performReadAndWait { (ctx) -> Int in
+            let fetchRequest = NSFetchRequest<ManagedObject>(
+                entityName: "ManagedObject"
+            )
+            return (try? ctx.count(for: fetchRequest)) ?? 0
+        }
+        
+        XCTAssert(count == 100)
+    }
+    
+    func testBatchInsert() {
+        let isInserted = expectation(description: "Objects are inserted.")
+        
+        var didChangeCount = 0
+        
+        let observer = NotificationCenter.default.addObserver(
+            forName: .NSManagedObjectContextObjectsDidChange,
+            object: nil,
+            queue: nil
+        ) { _ in didChangeCount += 1 }
+        
+        persistentController.batchInsert(
+            entityName: "ManagedObject",
+            objects: (0..<100).map { ["id": Int32($0)] },
+            chunkSize: 30
+        ) { (objectIDs, errorOrNil) in
+            XCTAssert(errorOrNil == nil)
+            XCTAssert(objectIDs.count == 100)
+            XCTAssert(objectIDs.reduce(true) { $0 && !$1.isTemporaryID })
+            isInserted.fulfill()
+        }
+        
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        NotificationCenter.default.removeObserver(observer)
+        
+        XCTAssert(didChangeCount > 0)
+        
+        let count = persistentController.performAndWait { (ctx) -> Int in
+            let fetchRequest = NSFetchRequest<ManagedObject>(
+                entityName: "ManagedObject"
+            )
+            return (try? ctx.count(for: fetchRequest)) ?? 0
+        }
+        
+        XCTAssert(count == 100)
+        
+        let batchSaves = persistentController.metrics.snapshot.batchSaves
+        XCTAssert(batchSaves.durations.count == 4)
+        XCTAssert(batchSaves.insertedObjectCount == 100)
+    }
+    
+    func testFlush() {
+        persistentController.saveMode = .coalescing(
+            window: 60, changeCountThreshold: 1000
+        )
+        
+        var isSaved = false
+        
+        persistentController.performAndWait { (ctx) in
+            let anObject = ManagedObject(managedObjectContext: ctx)
+            anObject.id = 1
+        }
+        
+        persistentController.save { (errorOrNil) in
+            XCTAssert(errorOrNil == nil)
+            isSaved = true
+        }
+        
+        // The deferred saving is enqueued on the fetching context's queue.
+        RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.1))
+        
+        persistentController.flush()
+        
+        XCTAssert(isSaved)
+    }
+    
+    func testFetchRequestTemplate() {
+        let template = ManagedObjectsInIDRange(lowerBound: 10, upperBound: 20)
+        
+        let fetchRequest = persistentController.fetchRequest(for: template)
+        let expectedFetchRequest = persistentController
+            .fetchRequestFromTemplate(
+                named: template.name,
+                substitutionVariables: ["lowerBound": 10, "upperBound": 20]
+            )!
+        
+        XCTAssert(fetchRequest.predicate == expectedFetchRequest.predicate)
+        XCTAssert(fetchRequest.entityName == "ManagedObject")
+        
+        // Binding the prepared template again does not leak the previous
+        // values.
+        let anotherFetchRequest = persistentController.fetchRequest(
+            for: ManagedObjectsInIDRange(lowerBound: 0, upperBound: 5)
+        )
+        
+        XCTAssert(anotherFetchRequest.predicate
+            == NSPredicate(format: "id >= 0 AND id < 5"))
+    }
+    
+    func testFetchRequestTemplateDeclarations() {
+        persistentController.performAndWait { (ctx) in
+            for idx in 0..<5 {
+                let anObject = ManagedObject(managedObjectContext: ctx)
+                anObject.id = Int32(idx)
+            }
+        }
+        
+        // Dictionary results do not include pending changes.
+        let isSaved = expectation(description: "Objects are saved.")
+        persistentController.save { _ in isSaved.fulfill() }
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        let fetchRequest = persistentController.fetchRequest(
+            for: IDsInIDRange(lowerBound: 0, upperBound: 3)
+        )
+        
+        XCTAssert(fetchRequest.resultType == .dictionaryResultType)
+        XCTAssert(fetchRequest.returnsObjectsAsFaults == false)
+        XCTAssert(fetchRequest.propertiesToFetch?.count == 1)
+        
+        let ids = persistentController.performAndWait { (ctx) in
+            try! ctx.fetch(fetchRequest).map { $0["id"] as! Int32 }
+        }
+        
+        XCTAssert(Set(ids) == [0, 1, 2])
+    }
+    
+    func testFetchObjectIDs() {
+        let template = ManagedObjectsInIDRange(lowerBound: 0, upperBound: 10)
+        
+        persistentController.performAndWait { (ctx) in
+            for idx in 0..<5 {
+                let anObject = ManagedObject(managedObjectContext: ctx)
+                anObject.id = Int32(idx)
+            }
+            try! ctx.save()
+            
+            let objectIDs = try! self.persistentController.fetchObjectIDs(
+                for: template, in: ctx
+            )
+            XCTAssert(objectIDs.count == 5)
+            
+            let anObject = ManagedObject(managedObjectContext: ctx)
+            anObject.id = 5
+            
+            // Cached until the fetching context saves.
+            let cachedObjectIDs = try! self.persistentController
+                .fetchObjectIDs(for: template, in: ctx)
+            XCTAssert(cachedObjectIDs.count == 5)
+            
+            try! ctx.save()
+            
+            let invalidatedObjectIDs = try! self.persistentController
+                .fetchObjectIDs(for: template, in: ctx)
+            XCTAssert(invalidatedObjectIDs.count == 6)
+        }
+    }
+    
+    func testStoreLoading() {
+        let controller = PersistentController(
+            store: .inMemory,
+            modelBundle: Bundle(for: type(of: self)),
+            modelName: "NSManagedObjectContextChangesExporterImporterTests",
+            warmUpEntityNames: ["ManagedObject"]
+        )
+        
+        let isLoaded = expectation(description: "Store is loaded.")
+        
+        controller.whenStoreLoaded { (errorOrNil) in
+            XCTAssert(errorOrNil == nil)
+            if case .loaded = controller.storeLoadingState {
+            } else {
+                XCTFail()
+            }
+            isLoaded.fulfill()
+        }
+        
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        // Waits for the warm-up.
+        let deadline = Date(timeIntervalSinceNow: 5)
+        while !controller.storeLoadingProgress.isFinished
+            && Date() < deadline
+        {
+            RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.01))
+        }
+        
+        XCTAssert(controller.storeLoadingProgress.isFinished)
+    }
+    
+    func testMetrics() {
+        let metrics = persistentController.metrics
+        metrics.slowTransactionThreshold = 0.01
+        
+        var slowTransactions = [PersistentControllerMetrics.Transaction]()
+        metrics.slowTransactionHandler = { slowTransactions.append($0) }
+        
+        persistentController.performAndWait { (ctx) in
+            for idx in 0..<10 {
+                let anObject = ManagedObject(managedObjectContext: ctx)
+                anObject.id = Int32(idx)
+            }
+        }
+        
+        persistentController.performAndWait { _ in
+            Thread.sleep(forTimeInterval: 0.02)
+        }
+        
+        persistentController.flush()
+        
+        let snapshot = metrics.snapshot
+        
+        XCTAssert(snapshot.execution.count >= 2)
+        XCTAssert(snapshot.queueWait.count == snapshot.execution.count)
+        XCTAssert(snapshot.fetchingContextSaves.durations.count == 1)
+        XCTAssert(snapshot.fetchingContextSaves.insertedObjectCount == 10)
+        XCTAssert(snapshot.savingContextSaves.insertedObjectCount == 10)
+        XCTAssert(snapshot.execution.maximumDuration >= 0.02)
+        XCTAssert(slowTransactions.contains {
+            if case .performAndWait = $0.kind { return true }
+            return false
+        })
+    }
+    
+    func testObservedContextEvents() {
+        // All hooks are called by default.
+        XCTAssert(persistentController.observedContextEvents == .all)
+        
+        let controller = ObservingPersistentController(
+            store: .inMemory,
+            modelBundle: Bundle(for: type(of: self)),
+            modelName: "NSManagedObjectContextChangesExporterImporterTests"
+        )
+        
+        controller.performAndWait { (ctx) in
+            let anObject = ManagedObject(managedObjectContext: ctx)
+            anObject.id = 1
+            try! ctx.save()
+        }
+        
+        // Objects-did-change is not opted in.
+        XCTAssert(controller.objectsDidChangeCount == 0)
+        XCTAssert(controller.insertedObjectIDs.count == 1)
+    }
+    
+    // MARK: Fetch Request Template Benchmark
+    func testFetchRequestFromTemplatePerformance() {
+        measure {
+            for idx in 0..<_fetchRequestCount {
+                _ = self.persistentController.fetchRequestFromTemplate(
+                    named: "ManagedObjectsInIDRange",
+                    substitutionVariables: [
+                        "lowerBound": idx, "upperBound": idx + 10
+                    ]
+                )
+            }
+        }
+    }
+    
+    func testPreparedFetchRequestPerformance() {
+        measure {
+            for idx in 0..<_fetchRequestCount {
+                _ = self.persistentController.fetchRequest(
+                    for: ManagedObjectsInIDRange(
+                        lowerBound: idx, upperBound: idx + 10
+                    )
+                )
+            }
+        }
+    }
+    
+    // MARK: Bulk Import Benchmark
+    func testBulkImportPerObjectPerformance() {
+        measure {
+            let controller = self._makeBulkImportPersistentController()
+            defer { self._removeBulkImportPersistentStores() }
+            
+            controller.performAndWait { (ctx) in
+                for idx in 0..<_bulkImportObjectCount {
+                    let anObject = ManagedObject(managedObjectContext: ctx)
+                    anObject.id = Int32(idx)
+                }
+            }
+            
+            let isSaved = self.expectation(description: "Objects are saved.")
+            controller.save { _ in isSaved.fulfill() }
+            self.waitForExpectations(timeout: 60, handler: nil)
+        }
+    }
+    
+    func testBulkImportBatchPerformance() {
+        let objects: [[String: Any]] = (0..<_bulkImportObjectCount).map {
+            ["id": Int32($0)]
+        }
+        
+        measure {
+            let controller = self._makeBulkImportPersistentController()
+            defer { self._removeBulkImportPersistentStores() }
+            
+            let isInserted = self.expectation(
+                description: "Objects are inserted."
+            )
+            controller.batchInsert(
+                entityName: "ManagedObject", objects: objects
+            ) { _, _ in isInserted.fulfill() }
+            self.waitForExpectations(timeout: 60, handler: nil)
+        }
+    }
+    
+    private func _makeBulkImportPersistentController()
+        -> PersistentController
+    {
+        let url = _bulkImportPersistentStoreDirectory
+            .appendingPathComponent(UUID().uuidString)
+            .appendingPathComponent("BulkImport.sqlite")
+        
+        return PersistentController(
+            store: .sqlite(url: url),
+            modelBundle: Bundle(for: type(of: self)),
+            modelName: "NSManagedObjectContextChangesExporterImporterTests"
+        )
+    }
+    
+    private func _removeBulkImportPersistentStores() {
+        try? FileManager.default.removeItem(
+            at: _bulkImportPersistentStoreDirectory
+        )
+    }
+    
+    private var _bulkImportPersistentStoreDirectory: URL {
+        return URL(fileURLWithPath: NSTemporaryDirectory())
+            .appendingPathComponent("PersistentControllerTests.BulkImport")
+    }
+}
+
+private let _bulkImportObjectCount = 20000
+
+private let _fetchRequestCount = 10000
+
+private class ObservingPersistentController: PersistentController {
+    var objectsDidChangeCount = 0
+    
+    var insertedObjectIDs = [NSManagedObjectID]()
+    
+    override var observedContextEvents: ContextEvents {
+        return .didSave
+    }
+    
+    override func context(
+        _ context: Context,
+        objectsDidChange changes: ManagedObjectChangeSet
+        )
+    {
+        objectsDidChangeCount += 1
+    }
+    
+    override func context(
+        _ context: Context,
+        didSave changes: ManagedObjectChangeSet
+        )
+    {
+        if case .forFetching = context {
+            insertedObjectIDs += changes.objectIDs(for: .inserted)
+        }
+    }
+}
+
+private struct ManagedObjectsInIDRange: FetchRequestTemplate {
+    typealias FetchRequestResult = ManagedObject
+    
+    enum Variable: String {
+        case lowerBound
+        case upperBound
+    }
+    
+    let lowerBound: Int
+    
+    let upperBound: Int
+    
+    var name: String { return "ManagedObjectsInIDRange" }
+    
+    var primitiveSubstitutionVariables: [Variable : Any] {
+        return [.lowerBound: lowerBound, .upperBound: upperBound]
+    }
+}
+
+private struct IDsInIDRange: FetchRequestTemplate {
+    typealias FetchRequestResult = NSDictionary
+    
+    typealias Variable = ManagedObjectsInIDRange.Variable
+    
+    let lowerBound: Int
+    
+    let upperBound: Int
+    
+    var name: String { return "ManagedObjectsInIDRange" }
+    
+    var primitiveSubstitutionVariables: [Variable : Any] {
+        return [.lowerBound: lowerBound, .upperBound: upperBound]
+    }
+    
+    var propertiesToFetch: [String] { return ["id"] }
+    
+    var returnsObjectsAsFaults: Bool { return false }
+}
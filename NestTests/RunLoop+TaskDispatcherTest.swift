@@ -48,4 +48,97 @@ class RunLoop_TaskDispatcherTest: XCTestCase {
             }
         }
     }
+    
+    func testScheduleFromBackgroundThreads() {
+        let expectation = self.expectation(
+            description: "testScheduleFromBackgroundThreads"
+        )
+        
+        let mainRunLoop = RunLoop.main
+        let taskCount = 100
+        var executedTaskCount = 0
+        
+        DispatchQueue.concurrentPerform(iterations: taskCount) { _ in
+            mainRunLoop.schedule(in: .commonModes, when: .nextLoopBegan) {
+                XCTAssert(Thread.isMainThread)
+                executedTaskCount += 1
+                if executedTaskCount == taskCount {
+                    expectation.fulfill()
+                }
+            }
+        }
+        
+        waitForExpectations(timeout: 1, handler: nil)
+    }
+    
+    func testTaskPriorityAndTimeBudget() {
+        let expectation = self.expectation(
+            description: "testTaskPriorityAndTimeBudget"
+        )
+        
+        let runLoop = RunLoop.current
+        runLoop.taskTimeBudget = 0.01
+        defer { runLoop.taskTimeBudget = .infinity }
+        
+        var executionOrder = [Int]()
+        
+        runLoop.schedule(in: .commonModes, when: .idle, priority: .low) {
+            executionOrder.append(0)
+            
+            XCTAssertEqual(executionOrder, [2, 1, 0])
+            expectation.fulfill()
+        }
+        
+        runLoop.schedule(
+            in: .commonModes, when: .idle, priority: .normal, cost: 0.02
+        ) {
+            executionOrder.append(1)
+        }
+        
+        runLoop.schedule(in: .commonModes, when: .idle, priority: .high) {
+            executionOrder.append(2)
+            Thread.sleep(forTimeInterval: 0.02)
+        }
+        
+        waitForExpectations(timeout: 1, handler: nil)
+    }
+    
+    func testCoalescingKey() {
+        let expectation = self.expectation(
+            description: "testCoalescingKey"
+        )
+        
+        let runLoop = RunLoop.current
+        
+        var replacedExecutions = [Int]()
+        var keptExecutions = [Int]()
+        
+        for index in 0..<10 {
+            runLoop.schedule(
+                in: .commonModes,
+                when: .idle,
+                coalescingKey: "replace",
+                policy: .replace
+            ) {
+                replacedExecutions.append(index)
+            }
+            
+            runLoop.schedule(
+                in: .commonModes,
+                when: .idle,
+                coalescingKey: "keepPending",
+                policy: .keepPending
+            ) {
+                keptExecutions.append(index)
+            }
+        }
+        
+        runLoop.schedule(in: .commonModes, when: .idle, priority: .low) {
+            XCTAssertEqual(replacedExecutions, [9])
+            XCTAssertEqual(keptExecutions, [0])
+            expectation.fulfill()
+        }
+        
+        waitForExpectations(timeout: 1, handler: nil)
+    }
 }
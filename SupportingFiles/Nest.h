@@ -13,3 +13,4 @@
 #import <Nest/ObjCDynamicPropertySynthesizing.h>
 #import <Nest/ObjCDynamicObject.h>
 #import <Nest/ObjCDynamicCoder.h>
+#import <Nest/ObjCDynamicObjectMappedArchive.h>